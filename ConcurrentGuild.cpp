@@ -0,0 +1,131 @@
+#include "ConcurrentGuild.hpp"
+#include <functional> // For std::hash
+#include <stdexcept>  // For std::invalid_argument
+
+/**
+* @brief Constructs an empty ConcurrentGuild
+* @param shardCount The number of independently locked shards. Must be at least 1.
+* @param policy The RemovalPolicy of every shard's Guild. Defaults to UNORDERED,
+*        since shards hold no meaningful cross-shard order anyway.
+* @throws std::invalid_argument If `shardCount` is 0
+*/
+ConcurrentGuild::ConcurrentGuild(size_t shardCount, RemovalPolicy policy) {
+    if (shardCount == 0) {
+        throw std::invalid_argument("A ConcurrentGuild needs at least one shard.");
+    }
+    shards_.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; i++) {
+        shards_.push_back(std::make_unique<Shard>(policy));
+    }
+}
+
+/**
+* @brief Picks the shard responsible for a player name
+* @param playerName A const reference to the player's name
+* @return A reference to the shard that holds (or would hold) the player
+*/
+ConcurrentGuild::Shard& ConcurrentGuild::shardFor(const std::string& playerName) const {
+    return *shards_[std::hash<std::string>{}(playerName) % shards_.size()];
+}
+
+/**
+* @brief Retrieves the number of shards
+* @return The size of shards_
+*/
+size_t ConcurrentGuild::getShardCount() const {
+    return shards_.size();
+}
+
+/**
+* @brief Counts the enlisted players across all shards
+* @return The total number of players. With concurrent writers the result is
+*         a sum of per-shard snapshots, not one atomic snapshot.
+*/
+size_t ConcurrentGuild::getPlayerCount() const {
+    size_t count = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex);
+        count += shard->guild.getPlayerCount();
+    }
+    return count;
+}
+
+/**
+* @brief Checks whether a player with the given name is enlisted
+* @param playerName A const reference to the player's name to search for
+* @return True if the player is in the guild, false otherwise
+* @note Takes only a shared lock on one shard
+*/
+bool ConcurrentGuild::hasPlayer(const std::string& playerName) const {
+    Shard& shard = shardFor(playerName);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.guild.hasPlayer(playerName);
+}
+
+/**
+* @brief Attempts to enlist a player into the guild
+* 
+* @param player An l-value reference to a Player object whose contents will be moved into the guild
+* @return True if the player was successfully enlisted, false if a player with the same name already exists
+* 
+* @post As Guild::enlistPlayer. Only the player's shard is locked, exclusively.
+*/
+bool ConcurrentGuild::enlistPlayer(Player& player) {
+    Shard& shard = shardFor(player.getName());
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.guild.enlistPlayer(player);
+}
+
+/**
+* @brief Moves a player from this guild to another ConcurrentGuild
+* 
+* @param playerName A const reference to the name of the player to move
+* @param target An l-value reference to the destination ConcurrentGuild
+* @return True if the player was successfully moved, 
+*       false if the player doesn't exist in this guild
+*       or if a player with the same name already exists in the target guild
+* 
+* @post As Guild::movePlayerTo. The source and target shards are locked
+*       exclusively in address order, so opposing transfers cannot deadlock.
+*/
+bool ConcurrentGuild::movePlayerTo(const std::string& playerName, ConcurrentGuild& target) {
+    Shard& source = shardFor(playerName);
+    Shard& destination = target.shardFor(playerName);
+    if (&source == &destination) { return false; } // Same guild: the name already exists in the target
+
+    // Always lock the lower-addressed shard first
+    Shard& first = (&source < &destination) ? source : destination;
+    Shard& second = (&source < &destination) ? destination : source;
+    std::unique_lock<std::shared_mutex> firstLock(first.mutex);
+    std::unique_lock<std::shared_mutex> secondLock(second.mutex);
+    return source.guild.movePlayerTo(playerName, destination.guild);
+}
+
+/**
+* @brief Copies a player from this guild to another ConcurrentGuild
+* 
+* @param playerName A const reference to the name of the player to copy
+* @param target An l-value reference to the destination ConcurrentGuild
+* @return True if the player was successfully copied, 
+*         false if the player doesn't exist in this guild
+*         or if a player with the same name already exists in the target guild
+* 
+* @post As Guild::copyPlayerTo. The source shard is share-locked and the target
+*       shard exclusively locked, in address order.
+*/
+bool ConcurrentGuild::copyPlayerTo(const std::string& playerName, ConcurrentGuild& target) {
+    Shard& source = shardFor(playerName);
+    Shard& destination = target.shardFor(playerName);
+    if (&source == &destination) { return false; }
+
+    std::shared_lock<std::shared_mutex> sourceLock(source.mutex, std::defer_lock);
+    std::unique_lock<std::shared_mutex> destinationLock(destination.mutex, std::defer_lock);
+    if (&source < &destination) {
+        sourceLock.lock();
+        destinationLock.lock();
+    } else {
+        destinationLock.lock();
+        sourceLock.lock();
+    }
+    return source.guild.copyPlayerTo(playerName, destination.guild);
+}
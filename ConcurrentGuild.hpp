@@ -0,0 +1,146 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "Guild.hpp"
+
+class ConcurrentGuild {
+    private:
+        /**
+        * @brief One slice of the roster: a Guild plus the reader/writer lock guarding it.
+        */
+        struct Shard {
+            mutable std::shared_mutex mutex; // Shared for lookups, exclusive for mutations
+            Guild guild;                     // The players whose names hash to this shard
+
+            explicit Shard(RemovalPolicy policy) : mutex(), guild(policy) {}
+        };
+
+        /**
+        * @brief The shards of the roster. Each player lives in exactly one, chosen by name hash.
+        * Held by pointer because std::shared_mutex cannot be moved.
+        */
+        std::vector<std::unique_ptr<Shard>> shards_;
+
+        /**
+        * @brief Picks the shard responsible for a player name
+        * @param playerName A const reference to the player's name
+        * @return A reference to the shard that holds (or would hold) the player
+        */
+        Shard& shardFor(const std::string& playerName) const;
+    public:
+        /**
+        * @brief Constructs an empty ConcurrentGuild
+        * @param shardCount The number of independently locked shards. Must be at least 1.
+        * @param policy The RemovalPolicy of every shard's Guild. Defaults to UNORDERED,
+        *        since shards hold no meaningful cross-shard order anyway.
+        * @throws std::invalid_argument If `shardCount` is 0
+        */
+        explicit ConcurrentGuild(size_t shardCount = 16, RemovalPolicy policy = RemovalPolicy::UNORDERED);
+
+        /**
+        * @brief Retrieves the number of shards
+        * @return The size of shards_
+        */
+        size_t getShardCount() const;
+
+        /**
+        * @brief Counts the enlisted players across all shards
+        * @return The total number of players. With concurrent writers the result is
+        *         a sum of per-shard snapshots, not one atomic snapshot.
+        */
+        size_t getPlayerCount() const;
+
+        /**
+        * @brief Checks whether a player with the given name is enlisted
+        * @param playerName A const reference to the player's name to search for
+        * @return True if the player is in the guild, false otherwise
+        * @note Takes only a shared lock on one shard
+        */
+        bool hasPlayer(const std::string& playerName) const;
+
+        /**
+        * @brief Attempts to enlist a player into the guild
+        * 
+        * @param player An l-value reference to a Player object whose contents will be moved into the guild
+        * @return True if the player was successfully enlisted, false if a player with the same name already exists
+        * 
+        * @post As Guild::enlistPlayer. Only the player's shard is locked, exclusively.
+        */
+        bool enlistPlayer(Player& player);
+
+        /**
+        * @brief Runs a read-only callback on a player while their shard is share-locked
+        * 
+        * @param playerName A const reference to the player's name to search for
+        * @param visit A callable invoked as visit(const Player&) if the player exists
+        * @return True if the player was found and visited, false otherwise
+        * @note References passed to `visit` must not outlive the call. A cold player is
+        *       rehydrated first, under an exclusive lock, since that writes the roster.
+        */
+        template <typename Visitor>
+        bool withPlayer(const std::string& playerName, Visitor visit) const {
+            Shard& shard = shardFor(playerName);
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                // The const overload, since several readers may hold the shard at once
+                auto playerItr = static_cast<const Guild&>(shard.guild).findPlayer(playerName);
+                if (playerItr != shard.guild.getPlayers().end()) {
+                    visit(*playerItr);
+                    return true;
+                }
+                if (!shard.guild.hasPlayer(playerName)) { return false; }
+            }
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto playerItr = shard.guild.findPlayer(playerName);
+            if (playerItr == shard.guild.getPlayers().end()) { return false; }
+            visit(*playerItr);
+            return true;
+        }
+
+        /**
+        * @brief Runs a mutating callback on a player while their shard is exclusively locked
+        * 
+        * @param playerName A const reference to the player's name to search for
+        * @param modify A callable invoked as modify(Player&) if the player exists.
+        *        It must not rename the player.
+        * @return True if the player was found and modified, false otherwise
+        */
+        template <typename Mutator>
+        bool modifyPlayer(const std::string& playerName, Mutator modify) {
+            Shard& shard = shardFor(playerName);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            return shard.guild.modifyPlayer(playerName, modify);
+        }
+
+        /**
+        * @brief Moves a player from this guild to another ConcurrentGuild
+        * 
+        * @param playerName A const reference to the name of the player to move
+        * @param target An l-value reference to the destination ConcurrentGuild
+        * @return True if the player was successfully moved, 
+        *       false if the player doesn't exist in this guild
+        *       or if a player with the same name already exists in the target guild
+        * 
+        * @post As Guild::movePlayerTo. The source and target shards are locked
+        *       exclusively in address order, so opposing transfers cannot deadlock.
+        */
+        bool movePlayerTo(const std::string& playerName, ConcurrentGuild& target);
+
+        /**
+        * @brief Copies a player from this guild to another ConcurrentGuild
+        * 
+        * @param playerName A const reference to the name of the player to copy
+        * @param target An l-value reference to the destination ConcurrentGuild
+        * @return True if the player was successfully copied, 
+        *         false if the player doesn't exist in this guild
+        *         or if a player with the same name already exists in the target guild
+        * 
+        * @post As Guild::copyPlayerTo. The source shard is share-locked and the target
+        *       shard exclusively locked, in address order.
+        */
+        bool copyPlayerTo(const std::string& playerName, ConcurrentGuild& target);
+};
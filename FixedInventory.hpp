@@ -0,0 +1,348 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GridView.hpp"
+#include "Inventory.hpp"
+#include "Item.hpp"
+
+/** An inventory whose grid shape is fixed at compile time.
+*
+* The ROWS * COLS cells are stored inline in a std::array, in the same row-major
+* order as Inventory, so a FixedInventory makes no heap allocation of its own
+* apart from the equipped item (and Item names too long for the small-string buffer).
+* It exposes the same GridView and OccupiedCells as Inventory, so read paths
+* written against those views work with either, and it converts to and from an
+* Inventory of the same shape.
+*
+* NOTE: FixedInventory is a standalone value type. Player, Guild and the codecs only
+*       hold a runtime-sized Inventory, so a FixedInventory cannot live inside a Player;
+*       handing one to a Player goes through toInventory(), which allocates the
+*       Inventory's grid on the heap like any other. Only store, emplace, autoStore,
+*       take, at and equip are mirrored; moveCell, swapCells, storeMany, the per-type
+*       tallies and change tracking exist on Inventory only.
+*
+* Being a template, it is defined entirely in this header.
+*/
+template <size_t ROWS, size_t COLS>
+class FixedInventory {
+    static_assert(ROWS > 0 && COLS > 0, "A FixedInventory needs at least one cell");
+
+    private:
+        // The grid, in row-major order
+        std::array<Item, ROWS * COLS> cells_;
+
+        // An owning pointer to a pool-allocated Item outside of the grid
+        std::unique_ptr<Item> equipped_;
+
+        // The total weight of the items in the grid, excluding `equipped_`
+        float weight_;
+
+        // The number of non-NONE items in the grid, excluding `equipped_`
+        size_t item_count_;
+
+        /**
+         * @brief Moves an item into an empty cell and updates `weight_` and `item_count_`.
+         * @param index The offset of an empty cell in `cells_`.
+         * @param pickup An r-value ref. to the non-NONE item to place.
+         */
+        void placeAt(size_t index, Item&& pickup) {
+            cells_[index] = std::move(pickup);
+            weight_ += cells_[index].weight_;
+            item_count_++;
+        }
+
+    public:
+        /**
+         * @brief Maps a row and column to its offset in the grid.
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @return The offset of the cell, usable in constant expressions.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         *  In a constant expression, an out-of-bounds index fails to compile instead.
+         */
+        static constexpr size_t cellIndex(size_t row, size_t col) {
+            if (row >= ROWS || col >= COLS) { throw std::out_of_range("Invalid inventory index."); }
+            return row * COLS + col;
+        }
+
+        /**
+         * @brief Retrieves the number of rows in the grid
+         * @return ROWS
+         */
+        static constexpr size_t getRows() { return ROWS; }
+
+        /**
+         * @brief Retrieves the number of columns in each row of the grid
+         * @return COLS
+         */
+        static constexpr size_t getCols() { return COLS; }
+
+        /**
+         * @brief Constructs an empty grid.
+         * @param equipped A pointer to an Item object allocated with `new`.
+         *  The FixedInventory takes ownership of it. Defaults to nullptr, if none provided.
+         */
+        explicit FixedInventory(Item* equipped = nullptr) : equipped_(equipped), weight_(0), item_count_(0) {}
+
+        /**
+         * @brief Copies an Inventory of the same shape.
+         * @param inventory A const ref. to the Inventory to copy, including its equipped item.
+         * @throws std::invalid_argument If `inventory` is not ROWS x COLS.
+         */
+        explicit FixedInventory(const Inventory& inventory) : FixedInventory() {
+            if (inventory.getRows() != ROWS || inventory.getCols() != COLS) {
+                throw std::invalid_argument("Inventory shape does not match the FixedInventory.");
+            }
+            RowView cells = inventory.view().cells();
+            std::copy(cells.begin(), cells.end(), cells_.begin());
+            if (inventory.getEquipped()) { equipped_.reset(new Item(*inventory.getEquipped())); }
+            weight_ = inventory.getWeight();
+            item_count_ = inventory.getCount();
+        }
+
+        /**
+         * @brief Copies this grid into a heap-allocated, runtime-sized Inventory, e.g. to hand to a Player.
+         * @return An Inventory of the same shape holding copies of the items and the equipped item.
+         */
+        Inventory toInventory() const& {
+            return Inventory(ROWS, COLS, std::vector<Item>(cells_.begin(), cells_.end()),
+                             equipped_ ? new Item(*equipped_) : nullptr);
+        }
+
+        /**
+         * @brief Moves this grid into a runtime-sized Inventory.
+         * @return An Inventory of the same shape that took over the items and the equipped item.
+         * @post This FixedInventory is left empty.
+         */
+        Inventory toInventory() && {
+            std::vector<Item> cells;
+            cells.reserve(ROWS * COLS);
+            for (Item& cell : cells_) { cells.push_back(std::exchange(cell, Item())); }
+            weight_ = 0;
+            item_count_ = 0;
+            return Inventory(ROWS, COLS, std::move(cells), equipped_.release());
+        }
+
+        /**
+         * @brief Copy constructor for the FixedInventory class.
+         * @param rhs A const l-value ref. to the FixedInventory object to copy.
+         * @post Creates a deep copy of `rhs`, including duplicating the equipped item.
+         */
+        FixedInventory(const FixedInventory& rhs)
+                : cells_(rhs.cells_), equipped_(rhs.equipped_ ? new Item(*rhs.equipped_) : nullptr),
+                  weight_(rhs.weight_), item_count_(rhs.item_count_) {}
+
+        /**
+         * @brief Move constructor for the FixedInventory class.
+         * @param rhs An r-value ref. to the FixedInventory object to move from.
+         * @post Moves every cell and the equipped item out of `rhs`, leaving it empty.
+         *  Since the cells are inline, this is O(ROWS * COLS), not O(1) as for Inventory.
+         */
+        FixedInventory(FixedInventory&& rhs) noexcept
+                : equipped_(std::move(rhs.equipped_)), weight_(rhs.weight_), item_count_(rhs.item_count_) {
+            for (size_t index = 0; index < ROWS * COLS; index++) { cells_[index] = std::exchange(rhs.cells_[index], Item()); }
+            rhs.weight_ = 0;
+            rhs.item_count_ = 0;
+        }
+
+        /**
+         * @brief Copy assignment operator for the FixedInventory class.
+         * @param rhs A const l-value ref. to the FixedInventory object to copy.
+         * @return A reference to the updated FixedInventory object.
+         * @post If the copy throws, this object is left unchanged.
+         */
+        FixedInventory& operator=(const FixedInventory& rhs) {
+            if (this != &rhs) {
+                FixedInventory copy(rhs);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment operator for the FixedInventory class.
+         * @param rhs An r-value ref. to the FixedInventory object to move from.
+         * @return A reference to the updated FixedInventory object.
+         * @post Destroys the overridden equipped item and leaves `rhs` empty.
+         */
+        FixedInventory& operator=(FixedInventory&& rhs) noexcept {
+            if (this != &rhs) {
+                for (size_t index = 0; index < ROWS * COLS; index++) { cells_[index] = std::exchange(rhs.cells_[index], Item()); }
+                equipped_ = std::move(rhs.equipped_);
+                weight_ = rhs.weight_;
+                item_count_ = rhs.item_count_;
+                rhs.weight_ = 0;
+                rhs.item_count_ = 0;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Retrieves the value stored in `equipped_`
+         * @return The Item pointer stored in `equipped_`
+         */
+        Item* getEquipped() const { return equipped_.get(); }
+
+        /**
+         * @brief Equips a new item.
+         * @param itemToEquip A pointer to the item to equip, allocated with `new`.
+         * @post Takes ownership of `itemToEquip`. As with Inventory::equip, ownership
+         *  of the previously equipped item passes back to the caller.
+         */
+        void equip(Item* itemToEquip) {
+            equipped_.release(); // The caller now owns the previously equipped item
+            equipped_.reset(itemToEquip);
+        }
+
+        /**
+         * @brief Discards the currently equipped item.
+         * @post Deallocates the equipped item, if any, and sets `equipped_` to nullptr.
+         */
+        void discardEquipped() { equipped_.reset(); }
+
+        /**
+         * @brief Exposes the grid without copying it.
+         * @return A read-only GridView over the grid, with row and cell access.
+         * @note The view is invalidated by moving from or assigning to this FixedInventory.
+         */
+        GridView view() const { return GridView(cells_.data(), ROWS, COLS); }
+
+        /**
+         * @brief Exposes the occupied cells of the grid without copying them.
+         * @return A range over the non-NONE cells with their row and column, in row-major order.
+         */
+        OccupiedCells occupied() const { return view().occupied(); }
+
+        /**
+         * @brief Retrieves the value stored in `weight_`
+         * @return The float value stored in `weight_`
+         */
+        float getWeight() const { return weight_; }
+
+        /**
+         * @brief Retrieves the value stored in `item_count_`
+         * @return The size_t value stored in `item_count_`
+         */
+        size_t getCount() const { return item_count_; }
+
+        /**
+         * @brief Retrieves the item located at the specified row and column.
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @return A const ref. to the item at the specified row and column.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        const Item& at(size_t row, size_t col) const { return cells_[cellIndex(row, col)]; }
+
+        /**
+         * @brief Retrieves the item at a row and column checked at compile time.
+         * @tparam ROW The row index; must be less than ROWS.
+         * @tparam COL The column index; must be less than COLS.
+         * @return A const ref. to the item at (ROW, COL).
+         */
+        template <size_t ROW, size_t COL>
+        const Item& get() const {
+            static_assert(ROW < ROWS && COL < COLS, "Invalid inventory index.");
+            return cells_[ROW * COLS + COL];
+        }
+
+        /**
+         * @brief Stores an item at the specified row and column.
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @param pickup A const ref. to the item to store at the specified location.
+         * @return True if the item was stored, false if the cell is already occupied.
+         * @post Updates `item_count_` and `weight_` if the Item is sucessfully added
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        bool store(size_t row, size_t col, const Item& pickup) { return store(row, col, Item(pickup)); }
+
+        /**
+         * @brief Stores an item at the specified row and column, moving it into the cell.
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @param pickup An r-value ref. to the item to store. It is only moved from if stored.
+         * @return True if the item was stored, false if the cell is already occupied.
+         * @post Updates `item_count_` and `weight_` if the Item is sucessfully added
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        bool store(size_t row, size_t col, Item&& pickup) {
+            size_t index = cellIndex(row, col);
+            if (cells_[index].type_ != NONE) { return false; } // Cell is occupied
+            if (pickup.type_ != NONE) { placeAt(index, std::move(pickup)); }
+            return true;
+        }
+
+        /**
+         * @brief Constructs an item directly in the specified cell.
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @param name The name of the new item. Pass an r-value to avoid copying it.
+         * @param weight A float representing the weight of the new item.
+         * @param type An ItemType specifying the type of the new item.
+         * @return True if the item was stored, false if the cell is already occupied.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        bool emplace(size_t row, size_t col, std::string name, float weight, ItemType type) {
+            return store(row, col, Item(std::move(name), weight, type));
+        }
+
+        /**
+         * @brief Removes the item from the specified cell.
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @return The removed item, moved out of the cell, or a NONE Item if the cell was empty.
+         * @post Updates `item_count_` and `weight_` if an item was removed.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        Item take(size_t row, size_t col) {
+            size_t index = cellIndex(row, col);
+            if (cells_[index].type_ == NONE) { return Item(); } // Nothing to take
+            Item taken = std::exchange(cells_[index], Item());
+            item_count_--;
+            weight_ = (item_count_ == 0) ? 0 : weight_ - taken.weight_;
+            return taken;
+        }
+
+        /**
+         * @brief Finds the first empty cell in row-major order.
+         * @return The (row, col) of the first NONE cell, or std::nullopt if the grid is full.
+         */
+        std::optional<std::pair<size_t, size_t>> findFreeSlot() const {
+            if (item_count_ == ROWS * COLS) { return std::nullopt; }
+            for (size_t index = 0; index < ROWS * COLS; index++) {
+                if (cells_[index].type_ == NONE) { return std::make_pair(index / COLS, index % COLS); }
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Stores an item in the first empty cell.
+         * @param pickup A const ref. to the item to store.
+         * @return The (row, col) where the item was stored, or std::nullopt if the grid is full.
+         */
+        std::optional<std::pair<size_t, size_t>> autoStore(const Item& pickup) {
+            auto slot = findFreeSlot();
+            if (slot) { store(slot->first, slot->second, pickup); }
+            return slot;
+        }
+
+        /**
+         * @brief Destructor for the FixedInventory class.
+         * @post Returns the equipped item's storage to the ItemPool.
+         */
+        ~FixedInventory() = default;
+};
+
+// The bag shapes used by the game data
+using Pouch = FixedInventory<4, 4>;
+using Backpack = FixedInventory<10, 10>;
+using BankTab = FixedInventory<8, 16>;
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include "Item.hpp"
+
+// The views in this file sit on hot read paths, so they are defined inline here.
+// They never own or copy cells; they are invalidated by any mutation of the grid they view.
+
+/**
+ * @brief A non-owning view of one row of an inventory grid.
+ */
+class RowView {
+    private:
+        // The first cell of the row
+        const Item* cells_;
+
+        // The number of cells in the row
+        size_t cols_;
+    public:
+        /**
+         * @brief Constructs a view over `cols` contiguous cells.
+         * @param cells A pointer to the first cell of the row.
+         * @param cols The number of cells in the row.
+         */
+        RowView(const Item* cells, size_t cols) : cells_(cells), cols_(cols) {}
+
+        /**
+         * @brief Retrieves the number of cells in the row
+         * @return The value stored in `cols_`
+         */
+        size_t size() const { return cols_; }
+
+        /**
+         * @brief Retrieves a cell without bounds checking
+         * @param col The column index within the row.
+         * @return A const ref. to the cell at `col`.
+         */
+        const Item& operator[](size_t col) const { return cells_[col]; }
+
+        /**
+         * @brief Retrieves a cell with bounds checking
+         * @param col The column index within the row.
+         * @return A const ref. to the cell at `col`.
+         * @throws std::out_of_range If `col` is out of bounds.
+         */
+        const Item& at(size_t col) const {
+            if (col >= cols_) { throw std::out_of_range("Invalid inventory index."); }
+            return cells_[col];
+        }
+
+        const Item* begin() const { return cells_; }
+        const Item* end() const { return cells_ + cols_; }
+};
+
+/**
+ * @brief A cell reported by OccupiedCells: its position and a reference to its Item.
+ */
+struct OccupiedCell {
+    size_t row;       // The row index of the cell
+    size_t col;       // The column index of the cell
+    const Item& item; // The non-NONE Item stored in the cell
+};
+
+/**
+ * @brief A range over the non-NONE cells of an inventory grid, in row-major order.
+ */
+class OccupiedCells {
+    private:
+        // The first cell of the grid
+        const Item* cells_;
+
+        // The total number of cells in the grid
+        size_t size_;
+
+        // The number of columns in each row of the grid
+        size_t cols_;
+    public:
+        /**
+         * @brief Walks the grid, stopping only on cells whose type is not NONE.
+         */
+        class iterator {
+            private:
+                const Item* base_;
+                size_t offset_;
+                size_t size_;
+                size_t cols_;
+
+                // Advances `offset_` to the next occupied cell, or to `size_`
+                void skipEmpty() {
+                    while (offset_ < size_ && base_[offset_].type_ == NONE) { offset_++; }
+                }
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = OccupiedCell;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = OccupiedCell;
+
+                iterator(const Item* base, size_t offset, size_t size, size_t cols)
+                        : base_(base), offset_(offset), size_(size), cols_(cols) {
+                    skipEmpty();
+                }
+
+                OccupiedCell operator*() const {
+                    return OccupiedCell{offset_ / cols_, offset_ % cols_, base_[offset_]};
+                }
+
+                iterator& operator++() {
+                    offset_++;
+                    skipEmpty();
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    iterator previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                bool operator==(const iterator& rhs) const { return offset_ == rhs.offset_ && base_ == rhs.base_; }
+                bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+        };
+
+        /**
+         * @brief Constructs a range over a row-major grid.
+         * @param cells A pointer to the first cell of the grid.
+         * @param size The total number of cells in the grid.
+         * @param cols The number of columns in each row of the grid.
+         */
+        OccupiedCells(const Item* cells, size_t size, size_t cols) : cells_(cells), size_(size), cols_(cols) {}
+
+        iterator begin() const { return iterator(cells_, 0, size_, cols_); }
+        iterator end() const { return iterator(cells_, size_, size_, cols_); }
+};
+
+/**
+ * @brief A non-owning, read-only view of a whole row-major inventory grid.
+ */
+class GridView {
+    private:
+        // The first cell of the grid
+        const Item* cells_;
+
+        // The number of rows in the grid
+        size_t rows_;
+
+        // The number of columns in each row of the grid
+        size_t cols_;
+    public:
+        /**
+         * @brief Steps through the grid one RowView at a time.
+         */
+        class iterator {
+            private:
+                const Item* row_;
+                size_t cols_;
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = RowView;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = RowView;
+
+                iterator(const Item* row, size_t cols) : row_(row), cols_(cols) {}
+
+                RowView operator*() const { return RowView(row_, cols_); }
+
+                iterator& operator++() {
+                    row_ += cols_;
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    iterator previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                bool operator==(const iterator& rhs) const { return row_ == rhs.row_; }
+                bool operator!=(const iterator& rhs) const { return row_ != rhs.row_; }
+        };
+
+        /**
+         * @brief Constructs a view over a row-major grid.
+         * @param cells A pointer to the first cell of the grid.
+         * @param rows The number of rows in the grid.
+         * @param cols The number of columns in each row of the grid.
+         */
+        GridView(const Item* cells, size_t rows, size_t cols) : cells_(cells), rows_(rows), cols_(cols) {}
+
+        /**
+         * @brief Retrieves the value stored in `rows_`
+         * @return The number of rows in the viewed grid
+         */
+        size_t getRows() const { return rows_; }
+
+        /**
+         * @brief Retrieves the value stored in `cols_`
+         * @return The number of columns in each row of the viewed grid
+         */
+        size_t getCols() const { return cols_; }
+
+        /**
+         * @brief Retrieves the cell at the specified row and column, without copying it.
+         * @param row The row index in the grid.
+         * @param col The column index in the grid.
+         * @return A const ref. to the cell.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        const Item& at(size_t row, size_t col) const {
+            if (row >= rows_ || col >= cols_) { throw std::out_of_range("Invalid inventory index."); }
+            return cells_[row * cols_ + col];
+        }
+
+        /**
+         * @brief Retrieves a view of one row.
+         * @param row The row index in the grid.
+         * @return A RowView over the row's cells.
+         * @throws std::out_of_range If the row is out of bounds.
+         */
+        RowView row(size_t row) const {
+            if (row >= rows_) { throw std::out_of_range("Invalid inventory index."); }
+            return RowView(cells_ + row * cols_, cols_);
+        }
+
+        /**
+         * @brief Retrieves every cell as one flat row in row-major order.
+         * @return A RowView over all rows * cols cells.
+         */
+        RowView cells() const { return RowView(cells_, rows_ * cols_); }
+
+        /**
+         * @brief Retrieves a range over the occupied (non-NONE) cells only.
+         * @return An OccupiedCells range in row-major order.
+         */
+        OccupiedCells occupied() const { return OccupiedCells(cells_, rows_ * cols_, cols_); }
+
+        iterator begin() const { return iterator(cells_, cols_); }
+        iterator end() const { return iterator(cells_ + rows_ * cols_, cols_); }
+};
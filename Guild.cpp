@@ -1,20 +1,758 @@
 #include "Guild.hpp"
+#include "MappedRoster.hpp"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+/**
+* @brief The number of players each aggregation task reduces sequentially.
+* Fixed so that the reduction order never depends on the thread count.
+*/
+static constexpr size_t AGGREGATION_CHUNK = 1024;
+
+/**
+* @brief Runs `task(chunk)` for every chunk in [0, chunkCount) across a pool of threads
+* 
+* @param chunkCount The number of chunks to process
+* @param threads The number of threads to use; 0 picks std::thread::hardware_concurrency()
+* @param task A callable invoked once per chunk index. Calls for different chunks may run concurrently.
+* @note Idle threads claim the next unprocessed chunk, so uneven chunks balance out.
+*       The calling thread works too, and a request for one thread never spawns any.
+*       If a task throws, the remaining chunks are skipped and the first exception is rethrown.
+*       If a thread cannot be started, the chunks are shared among the threads already running.
+*/
+template <typename Task>
+static void forEachChunk(size_t chunkCount, size_t threads, Task task) {
+    if (chunkCount == 0) { return; }
+    if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+    threads = std::min(threads, chunkCount);
+
+    std::atomic<size_t> nextChunk{0};
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    auto worker = [&]() {
+        try {
+            for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) { task(chunk); }
+        } catch (...) {
+            nextChunk = chunkCount; // Stop the other workers early
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure) { failure = std::current_exception(); }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1); // Before any thread starts, so only the thread constructor can throw below
+    for (size_t i = 1; i < threads; i++) {
+        try {
+            pool.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break; // Out of threads; the workers already started and the calling thread cover the rest
+        }
+    }
+    worker();
+    for (auto& thread : pool) { thread.join(); }
+    if (failure) { std::rethrow_exception(failure); }
+}
 
 /**
  * @brief Constructs a new Guild object. Initializes the enlisted_players vector.
+ * @param policy How removals close the gap in enlisted_players. Defaults to STABLE.
+ * @param resource The memory resource for the roster and its players' inventories,
+ *        e.g. a std::pmr::monotonic_buffer_resource per shard, so that tearing the guild down
+ *        releases one arena. It must outlive the guild. Defaults to the default resource.
+ * @note Players moved in from a guild on the same resource are moved by pointer;
+ *       from any other, their inventories are copied into this guild's resource.
+ *       A copy of the guild, like a copy of a std::pmr container, uses the default resource.
  */
-Guild::Guild() : enlisted_players{std::vector<Player>()} {}
+Guild::Guild(RemovalPolicy policy, std::pmr::memory_resource* resource)
+        : enlisted_players{std::pmr::vector<Player>(resource)},
+          player_index_{std::pmr::unordered_map<std::string, RosterEntry>(resource)},
+          next_join_{0}, removal_policy_{policy},
+          join_order_{std::pmr::map<std::uint64_t, std::string>(resource)},
+          mapped_roster_{}, mapped_claimed_{}, mapped_claimed_count_{0}, cold_players_{}, access_clock_{0},
+          tiering_policy_{TieringPolicy{std::numeric_limits<std::uint64_t>::max(), 0}}, tiering_stats_{0, 0, 0, 0, 0},
+          index_{}, stale_players_{}, index_all_stale_{false} {}
+
+/**
+* @brief Retrieves the memory resource of enlisted_players
+* @return The resource passed to the constructor
+*/
+std::pmr::memory_resource* Guild::getMemoryResource() const {
+    return enlisted_players.get_allocator().resource();
+}
+
+/**
+* @brief Refreshes the slots stored in player_index_ for every player at or after `first`
+* @param first The first slot in enlisted_players whose index entry may be stale
+*/
+void Guild::reindexFrom(size_t first) {
+    for (size_t slot = first; slot < enlisted_players.size(); slot++) {
+        player_index_[enlisted_players[slot].getName()].slot = slot;
+    }
+}
+
+/**
+* @brief Finds where a player who joined at `joined` belongs in a join-ordered enlisted_players
+* @param joined The player's join counter
+* @return The first slot whose player joined later, or enlisted_players.size(). O(log n).
+*/
+size_t Guild::findJoinSlot(std::uint64_t joined) const {
+    auto slotItr = std::upper_bound(enlisted_players.begin(), enlisted_players.end(), joined,
+        [this](std::uint64_t join, const Player& player) { return join < player_index_.at(player.getName()).joined; });
+    return static_cast<size_t>(slotItr - enlisted_players.begin());
+}
+
+/**
+* @brief Sorts enlisted_players back into join order and refreshes every slot in player_index_
+* @note O(n log n); each player is moved once
+*/
+void Guild::restoreJoinOrder() {
+    std::vector<std::pair<std::uint64_t, size_t>> joins;
+    joins.reserve(enlisted_players.size());
+    for (size_t slot = 0; slot < enlisted_players.size(); slot++) {
+        joins.emplace_back(player_index_.at(enlisted_players[slot].getName()).joined, slot);
+    }
+    std::sort(joins.begin(), joins.end());
+
+    std::pmr::vector<Player> ordered(enlisted_players.get_allocator());
+    ordered.reserve(enlisted_players.capacity());
+    for (const auto& join : joins) { ordered.push_back(std::move(enlisted_players[join.second])); }
+    enlisted_players.swap(ordered);
+    reindexFrom(0);
+}
+
+/**
+* @brief Files a player who entered enlisted_players in join_order_, under JOIN_ORDER
+* @param playerName A const reference to the player's name
+* @param joined The player's join counter
+*/
+void Guild::noteJoined(const std::string& playerName, std::uint64_t joined) {
+    if (removal_policy_ == RemovalPolicy::JOIN_ORDER) { join_order_.emplace(joined, playerName); }
+}
+
+/**
+* @brief Removes a player who is leaving enlisted_players from join_order_, under JOIN_ORDER
+* @param joined The player's join counter
+*/
+void Guild::noteLeft(std::uint64_t joined) {
+    if (removal_policy_ == RemovalPolicy::JOIN_ORDER) { join_order_.erase(joined); }
+}
+
+/**
+* @brief Makes room for a batch of players about to be appended to enlisted_players
+* @param count The number of players in the batch
+* @note Grows only when the room is short, and then to at least twice the current capacity,
+*       so a run of small batches still reallocates geometrically
+*/
+void Guild::reserveForBatch(size_t count) {
+    size_t needed = enlisted_players.size() + count;
+    if (needed > enlisted_players.capacity()) {
+        enlisted_players.reserve(std::max(2 * enlisted_players.capacity(), needed));
+    }
+    size_t indexRoom = static_cast<size_t>(player_index_.bucket_count() * player_index_.max_load_factor());
+    if (player_index_.size() + count > indexRoom) {
+        player_index_.reserve(std::max(2 * player_index_.size(), player_index_.size() + count));
+    }
+}
+
+/**
+* @brief Adds an index entry for a player about to be appended to enlisted_players
+* @param playerName A const reference to the name of the incoming player
+* @return True if the entry was added, false if the name is already enlisted, cold or still mapped
+*/
+bool Guild::indexNewPlayer(const std::string& playerName) {
+    if (cold_players_.count(playerName) != 0 || findMappedSlot(playerName)) { return false; }
+    auto inserted = player_index_.emplace(playerName, RosterEntry{enlisted_players.size(), next_join_, access_clock_, false});
+    if (!inserted.second) { return false; }
+    noteJoined(playerName, next_join_++);
+    return true;
+}
+
+/**
+* @brief Appends a player whose entry indexNewPlayer() just added
+* @param playerName A const reference to the name passed to indexNewPlayer()
+* @param player The player to move (or copy) into enlisted_players
+* @throws Whatever the append throws, after removing the entry again, so the guild is unchanged
+*/
+void Guild::appendNewPlayer(const std::string& playerName, Player&& player) {
+    try {
+        enlisted_players.push_back(std::move(player));
+    } catch (...) {
+        unindexNewPlayer(playerName);
+        throw;
+    }
+}
+
+void Guild::appendNewPlayer(const std::string& playerName, const Player& player) {
+    try {
+        enlisted_players.push_back(player);
+    } catch (...) {
+        unindexNewPlayer(playerName);
+        throw;
+    }
+}
+
+/**
+* @brief Removes the entry indexNewPlayer() added for a player whose append failed
+* @param playerName A const reference to the name passed to indexNewPlayer()
+*/
+void Guild::unindexNewPlayer(const std::string& playerName) {
+    auto entryItr = player_index_.find(playerName);
+    noteLeft(entryItr->second.joined);
+    player_index_.erase(entryItr);
+    next_join_--;
+}
+
+/**
+* @brief Removes the player at `slot` from enlisted_players according to removal_policy_
+* @param slot The slot to remove. Its player_index_ entry must already be erased.
+* @post Every remaining player's index entry points at its new slot
+*/
+void Guild::removePlayerAt(size_t slot) {
+    if (removal_policy_ == RemovalPolicy::STABLE) {
+        enlisted_players.erase(enlisted_players.begin() + slot);
+        reindexFrom(slot);
+        return;
+    }
+
+    size_t last = enlisted_players.size() - 1;
+    if (slot != last) {
+        enlisted_players[slot] = std::move(enlisted_players[last]);
+        player_index_[enlisted_players[slot].getName()].slot = slot;
+    }
+    enlisted_players.pop_back();
+}
+
+/**
+* @brief Resolves a mutable access to a player, materializing them if needed
+* @param playerName A const reference to the player's name to search for
+* @return The player's index entry, or nullptr if they are not in the guild
+* @post Counts as an access for tiering, and stamps the player as active
+*/
+Guild::RosterEntry* Guild::accessPlayer(const std::string& playerName) {
+    access_clock_++;
+    std::uint64_t coldHits = tiering_stats_.cold_hits;
+    materializePlayer(playerName);
+    auto slotItr = player_index_.find(playerName);
+    if (slotItr == player_index_.end()) {
+        tiering_stats_.misses++;
+        return nullptr;
+    }
+    if (tiering_stats_.cold_hits == coldHits) { tiering_stats_.hot_hits++; }
+    slotItr->second.last_access = access_clock_;
+    return &slotItr->second;
+}
+
+/**
+* @brief Flags a player whose inventory may change behind index_'s back
+* @param entry The player's index entry
+* @param playerName A const reference to the player's name
+*/
+void Guild::markIndexStale(RosterEntry& entry, const std::string& playerName) {
+    if (!index_ || entry.index_stale) { return; }
+    entry.index_stale = true;
+    stale_players_.push_back(playerName);
+}
+
+/**
+* @brief Files a player appended to enlisted_players in index_, if indexing is enabled
+* @param player A const reference to the player
+*/
+void Guild::indexPlayer(const Player& player) {
+    if (index_) { index_->add(player.getName(), player.getInventoryRef()); }
+}
+
+/**
+* @brief Visits every player of the guild, enlisted, cold or still mapped, without decoding any
+* @param visitPlayer A callable invoked as visitPlayer(const Player&) per enlisted player
+* @param visitRecord A callable invoked as visitRecord(const PlayerCodec::RecordView&)
+*        per cold or still-mapped player
+*/
+template <typename PlayerVisitor, typename RecordVisitor>
+void Guild::forEachMember(PlayerVisitor visitPlayer, RecordVisitor visitRecord) const {
+    for (const Player& player : enlisted_players) { visitPlayer(player); }
+    for (const auto& cold : cold_players_) {
+        visitRecord(PlayerCodec::RecordView(cold.second.record.data(), cold.second.record.size()));
+    }
+    for (size_t slot = 0; slot < mapped_claimed_.size(); slot++) {
+        if (!mapped_claimed_[slot]) { visitRecord(mapped_roster_->getRecord(slot)); }
+    }
+}
+
+/**
+* @brief Adds every player of the guild, enlisted, cold or still mapped, to an index
+* @param index An l-value reference to the GuildIndex to fill
+*/
+void Guild::fillIndex(GuildIndex& index) const {
+    forEachMember([&](const Player& player) { index.add(player.getName(), player.getInventoryRef()); },
+                  [&](const PlayerCodec::RecordView& record) { index.add(record); });
+}
+
+/**
+* @brief Clears every RosterEntry::index_stale flag and the lists of stale players
+*/
+void Guild::clearIndexStaleness() {
+    for (const std::string& playerName : stale_players_) {
+        auto entryItr = player_index_.find(playerName);
+        if (entryItr != player_index_.end()) { entryItr->second.index_stale = false; }
+    }
+    stale_players_.clear();
+    index_all_stale_ = false;
+}
+
+/**
+* @brief Re-indexes the stale players, so that index_ matches every inventory again
+*/
+void Guild::refreshIndex() {
+    if (index_all_stale_) {
+        clearIndexStaleness();
+        index_->clear();
+        fillIndex(*index_);
+        return;
+    }
+    for (const std::string& playerName : stale_players_) {
+        auto entryItr = player_index_.find(playerName);
+        if (entryItr == player_index_.end() || !entryItr->second.index_stale) { continue; }
+        entryItr->second.index_stale = false;
+        index_->add(playerName, enlisted_players[entryItr->second.slot].getInventoryRef());
+    }
+    stale_players_.clear();
+}
+
+/**
+* @brief Retrieves the value stored in removal_policy_
+* @return The RemovalPolicy this guild applies to removals
+*/
+RemovalPolicy Guild::getRemovalPolicy() const {
+    return removal_policy_;
+}
+
+/**
+* @brief Changes how later removals close the gap in enlisted_players
+* @param policy The RemovalPolicy to apply from now on
+* @note Switching to STABLE from another policy sorts enlisted_players back into join order,
+*       in O(n log n), which invalidates iterators into it. Switching to JOIN_ORDER
+*       builds its join index, in O(n log n).
+*/
+void Guild::setRemovalPolicy(RemovalPolicy policy) {
+    if (policy == RemovalPolicy::STABLE && removal_policy_ != RemovalPolicy::STABLE) { restoreJoinOrder(); }
+    if (policy == RemovalPolicy::JOIN_ORDER && removal_policy_ != RemovalPolicy::JOIN_ORDER) {
+        for (const auto& entry : player_index_) { join_order_.emplace(entry.second.joined, entry.first); }
+    } else if (policy != RemovalPolicy::JOIN_ORDER) {
+        join_order_.clear();
+    }
+    removal_policy_ = policy;
+}
+
+/**
+* @brief Lists the enlisted players ordered by when they joined this guild
+* 
+* @return Iterators into enlisted_players, earliest join first.
+*         O(n) under STABLE and JOIN_ORDER, O(n log n) under UNORDERED.
+* @note The iterators allow mutation, so with indexes enabled the next query rebuilds them.
+*       Changes made through them after that query are missed by the indexes, so do not hold
+*       them across findPlayersCarrying() or findPlayersHeavierThan().
+*/
+std::vector<std::pmr::vector<Player>::iterator> Guild::getPlayersByJoinTime() {
+    if (index_) { index_all_stale_ = true; }
+    std::vector<std::pmr::vector<Player>::iterator> ordered;
+    ordered.reserve(enlisted_players.size());
+    if (removal_policy_ == RemovalPolicy::STABLE) {
+        for (auto itr = enlisted_players.begin(); itr != enlisted_players.end(); ++itr) { ordered.push_back(itr); }
+        return ordered;
+    }
+    if (removal_policy_ == RemovalPolicy::JOIN_ORDER) {
+        for (const auto& join : join_order_) { ordered.push_back(enlisted_players.begin() + player_index_.at(join.second).slot); }
+        return ordered;
+    }
+
+    std::vector<std::pair<std::uint64_t, size_t>> joins;
+    joins.reserve(player_index_.size());
+    for (const auto& entry : player_index_) { joins.emplace_back(entry.second.joined, entry.second.slot); }
+    std::sort(joins.begin(), joins.end());
+    for (const auto& join : joins) { ordered.push_back(enlisted_players.begin() + join.second); }
+    return ordered;
+}
 
 /**
 * @brief Searches for a player in the guild by name
 * 
 * @param playerName A const reference to the player's name to search for
-* @return std::vector<Player>::iterator An iterator pointing to the found player, or enlisted_players.end() if not found
+* @return std::pmr::vector<Player>::iterator An iterator pointing to the found player, or enlisted_players.end() if not found
+* @note Average O(1): resolved through player_index_ rather than a scan of enlisted_players.
+*       A cold or still-mapped player is materialized first, since the iterator allows mutation.
+*       Counts as an access for tiering, and stamps the player as active.
+*       With indexes enabled, the player is re-indexed by the next query;
+*       prefer modifyPlayer() to re-index them at once. Changes made through the
+*       iterator after that query are missed by the indexes, so do not hold it across queries.
+*/
+std::pmr::vector<Player>::iterator Guild::findPlayer(const std::string& playerName) {
+    RosterEntry* entry = accessPlayer(playerName);
+    if (!entry) { return enlisted_players.end(); }
+    markIndexStale(*entry, playerName);
+    return enlisted_players.begin() + entry->slot;
+}
+
+/**
+* @brief Searches for a player in the guild by name without allowing modification
+* 
+* @param playerName A const reference to the player's name to search for
+* @return std::pmr::vector<Player>::const_iterator An iterator pointing to the found player, or getPlayers().end() if not found
+* @note Never materializes a cold or mapped player; use findColdPlayer() or findMappedPlayer()
+*       to read one in place. Not counted as an access for tiering.
+*/
+std::pmr::vector<Player>::const_iterator Guild::findPlayer(const std::string& playerName) const {
+    auto slotItr = player_index_.find(playerName);
+    if (slotItr == player_index_.end()) { return enlisted_players.end(); }
+    return enlisted_players.begin() + slotItr->second.slot;
+}
+
+/**
+* @brief Checks whether a player with the given name is enlisted
+* @param playerName A const reference to the player's name to search for
+* @return True if the player is in the guild, enlisted, cold or still mapped, false otherwise
+*/
+bool Guild::hasPlayer(const std::string& playerName) const {
+    return player_index_.count(playerName) != 0 || cold_players_.count(playerName) != 0 || findMappedSlot(playerName);
+}
+
+/**
+* @brief Retrieves the number of players in the guild
+* @return The size of enlisted_players plus the cold players and those that are still only mapped
+*/
+size_t Guild::getPlayerCount() const {
+    return enlisted_players.size() + cold_players_.size() + getMappedPlayerCount();
+}
+
+/**
+* @brief Finds a player that still lives only in mapped_roster_
+* @param playerName A const reference to the player's name to search for
+* @return The player's roster position, or std::nullopt if they are not mapped or already claimed
+*/
+std::optional<size_t> Guild::findMappedSlot(const std::string& playerName) const {
+    if (!mapped_roster_ || mapped_claimed_count_ == mapped_claimed_.size()) { return std::nullopt; }
+    std::optional<size_t> slot = mapped_roster_->find(playerName);
+    if (slot && mapped_claimed_[*slot]) { return std::nullopt; }
+    return slot;
+}
+
+/**
+* @brief Decodes a cold or mapped player into enlisted_players so that it can be mutated
+* @param playerName A const reference to the player's name
+* @post A cold player is rehydrated with their original join time and leaves cold_players_.
+*       Under STABLE they return to their join-order slot, otherwise they are appended.
+*       If the player lived only in mapped_roster_, they are enlisted and their record is claimed.
+*       Otherwise nothing changes.
+*/
+void Guild::materializePlayer(const std::string& playerName) {
+    auto coldItr = cold_players_.find(playerName);
+    if (coldItr != cold_players_.end()) {
+        Player player = PlayerCodec::decode(coldItr->second.record);
+        std::uint64_t joined = coldItr->second.joined;
+        // Later joiners may have been enlisted meanwhile, so STABLE puts the player back between them
+        size_t slot = (removal_policy_ == RemovalPolicy::STABLE) ? findJoinSlot(joined) : enlisted_players.size();
+        enlisted_players.insert(enlisted_players.begin() + slot, std::move(player));
+        cold_players_.erase(coldItr);
+        player_index_.emplace(playerName, RosterEntry{slot, joined, access_clock_, false});
+        noteJoined(playerName, joined);
+        reindexFrom(slot + 1);
+        tiering_stats_.cold_hits++;
+        return;
+    }
+
+    std::optional<size_t> slot = findMappedSlot(playerName);
+    if (!slot) { return; }
+    Player player = mapped_roster_->getRecord(*slot).materialize();
+
+    // Claim the record first, so indexNewPlayer no longer sees the name as mapped
+    mapped_claimed_[*slot] = true;
+    mapped_claimed_count_++;
+    indexNewPlayer(playerName);
+    try {
+        appendNewPlayer(playerName, std::move(player));
+    } catch (...) {
+        mapped_claimed_[*slot] = false; // The record stays the player's only copy
+        mapped_claimed_count_--;
+        throw;
+    }
+}
+
+/**
+* @brief Attaches a read-only roster file whose players join this guild without being decoded
+* 
+* @param roster A shared pointer to the opened MappedRoster
+* @post Every player in the file counts as enlisted. Players already in enlisted_players
+*       or the cold store take precedence over a mapped record with the same name.
+*       Any previously attached roster is replaced and its unclaimed players are dropped.
+* @note O(enlisted players * log(roster size)); the file itself is not read.
+*/
+void Guild::attachRoster(std::shared_ptr<const MappedRoster> roster) {
+    mapped_roster_ = std::move(roster);
+    mapped_claimed_.assign(mapped_roster_ ? mapped_roster_->getSize() : 0, false);
+    mapped_claimed_count_ = 0;
+    if (index_) { index_all_stale_ = true; } // The old roster's unclaimed players leave, the new ones join
+    if (!mapped_roster_) { return; }
+
+    auto claim = [&](std::string_view playerName) {
+        std::optional<size_t> slot = mapped_roster_->find(playerName);
+        if (slot) {
+            mapped_claimed_[*slot] = true;
+            mapped_claimed_count_++;
+        }
+    };
+    for (const Player& player : enlisted_players) { claim(player.getNameView()); }
+    for (const auto& cold : cold_players_) { claim(cold.first); }
+}
+
+/**
+* @brief Retrieves the number of players that are still only mapped
+* @return The number of mapped_roster_ entries not yet materialized, or 0 without a roster
 */
-std::vector<Player>::iterator Guild::findPlayer(const std::string& playerName) {
-    return std::find_if(enlisted_players.begin(), enlisted_players.end(), [&playerName](const Player& p) {
-        return p.getName() == playerName;
+size_t Guild::getMappedPlayerCount() const {
+    return mapped_claimed_.size() - mapped_claimed_count_;
+}
+
+/**
+* @brief Reads a player that has not been materialized, in place
+* 
+* @param playerName A const reference to the player's name to search for
+* @return A view of the player's mapped record, or std::nullopt if the player is not mapped
+*         or already lives in enlisted_players
+*/
+std::optional<PlayerCodec::RecordView> Guild::findMappedPlayer(const std::string& playerName) const {
+    std::optional<size_t> slot = findMappedSlot(playerName);
+    if (!slot) { return std::nullopt; }
+    return mapped_roster_->getRecord(*slot);
+}
+
+/**
+* @brief Saves every player of the guild to a roster file that attachRoster() can map
+* @param path The file to create or replace
+* @throws std::system_error If the file cannot be written
+*/
+void Guild::saveRoster(const std::string& path) const {
+    MappedRoster::write(*this, path);
+}
+
+/**
+* @brief Retrieves the value stored in tiering_policy_
+* @return The thresholds demoteIdlePlayers() applies
+*/
+TieringPolicy Guild::getTieringPolicy() const {
+    return tiering_policy_;
+}
+
+/**
+* @brief Changes the thresholds demoteIdlePlayers() applies
+* @param policy The TieringPolicy to apply from the next sweep on.
+*        The default policy, with an unlimited max_idle, never demotes anyone.
+*/
+void Guild::setTieringPolicy(const TieringPolicy& policy) {
+    tiering_policy_ = policy;
+}
+
+/**
+* @brief Compacts idle players out of enlisted_players into the cold store
+* 
+* @return The number of players demoted
+* 
+* @post Every enlisted player idle for more than max_idle accesses is encoded as a
+*       PlayerCodec record, keyed by name, until min_hot_players remain enlisted.
+*       The remaining players keep their order. They still count as members, and their
+*       next mutable access (findPlayer, movePlayerTo, ...) rehydrates them with a move.
+*       The roster's spare capacity is released once it holds a quarter of it or less.
+*       A player whose record fails to encode or decode back stays enlisted, and is
+*       counted in TieringStats::failed_demotions.
+* @note O(n) in enlisted players, plus one decode per demoted player to validate their record;
+*       call it from the game loop, not per lookup.
+*/
+size_t Guild::demoteIdlePlayers() {
+    size_t hot = enlisted_players.size();
+    std::vector<bool> vacated(hot, false);
+    size_t firstVacated = hot;
+    size_t demoted = 0;
+    for (size_t slot = 0; slot < enlisted_players.size() && hot > tiering_policy_.min_hot_players; slot++) {
+        auto entryItr = player_index_.find(enlisted_players[slot].getName());
+        if (access_clock_ - entryItr->second.last_access <= tiering_policy_.max_idle) { continue; }
+        // A cold player is never re-indexed, so file their final inventory now
+        if (entryItr->second.index_stale) { indexPlayer(enlisted_players[slot]); }
+
+        // A record that does not decode would leave the player unreachable, so keep them hot instead
+        std::vector<std::uint8_t> record;
+        try {
+            record = PlayerCodec::encode(enlisted_players[slot]);
+            PlayerCodec::decode(record);
+        } catch (const std::invalid_argument&) {
+            tiering_stats_.failed_demotions++;
+            continue;
+        }
+        record.shrink_to_fit();
+        std::uint64_t joined = entryItr->second.joined;
+        noteLeft(joined);
+        auto entry = player_index_.extract(entryItr); // Reuses the index key for the cold store
+        cold_players_.emplace(std::move(entry.key()), ColdPlayer{std::move(record), joined});
+
+        vacated[slot] = true;
+        firstVacated = std::min(firstVacated, slot);
+        hot--;
+        demoted++;
+    }
+    if (demoted == 0) { return 0; }
+
+    // Compact the remaining players in a single pass
+    size_t write = firstVacated;
+    for (size_t read = firstVacated; read < enlisted_players.size(); read++) {
+        if (vacated[read]) { continue; }
+        enlisted_players[write++] = std::move(enlisted_players[read]);
+    }
+    enlisted_players.erase(enlisted_players.begin() + write, enlisted_players.end());
+    reindexFrom(firstVacated);
+    if (enlisted_players.size() <= enlisted_players.capacity() / 4) { enlisted_players.shrink_to_fit(); }
+
+    tiering_stats_.demotions += demoted;
+    return demoted;
+}
+
+/**
+* @brief Retrieves the number of players in the cold store
+* @return The size of cold_players_
+*/
+size_t Guild::getColdPlayerCount() const {
+    return cold_players_.size();
+}
+
+/**
+* @brief Reads a cold player in place, without rehydrating them
+* 
+* @param playerName A const reference to the player's name to search for
+* @return A view of the player's encoded record, or std::nullopt if the player is not cold.
+*         The view is invalidated when the player is rehydrated.
+*/
+std::optional<PlayerCodec::RecordView> Guild::findColdPlayer(const std::string& playerName) const {
+    auto coldItr = cold_players_.find(playerName);
+    if (coldItr == cold_players_.end()) { return std::nullopt; }
+    const std::vector<std::uint8_t>& record = coldItr->second.record;
+    return PlayerCodec::RecordView(record.data(), record.size());
+}
+
+/**
+* @brief Retrieves the value stored in tiering_stats_
+* @return The lookup and demotion counters since the guild was constructed
+*/
+TieringStats Guild::getTieringStats() const {
+    return tiering_stats_;
+}
+
+/**
+* @brief Starts maintaining the item and weight indexes used by findPlayersCarrying()
+*        and findPlayersHeavierThan()
+* @post Every player, enlisted, cold or still mapped, is indexed. From now on enlisting,
+*       moving, copying, releasing and modifyPlayer() keep the indexes in step.
+* @note O(items in the guild). Does nothing if indexing is already enabled.
+*/
+void Guild::enableIndexes() {
+    if (index_) { return; }
+    index_.emplace();
+    fillIndex(*index_);
+}
+
+/**
+* @brief Stops maintaining the indexes and releases their memory
+* @post Queries fall back to scanning every player
+*/
+void Guild::disableIndexes() {
+    clearIndexStaleness();
+    stale_players_.shrink_to_fit();
+    index_.reset();
+}
+
+/**
+* @brief Checks whether the indexes are maintained
+* @return True between enableIndexes() and disableIndexes(), false otherwise
+*/
+bool Guild::hasIndexes() const {
+    return index_.has_value();
+}
+
+/**
+* @brief Finds the players carrying an item, in the bag or equipped
+* 
+* @param itemName A const reference to the item name to search for
+* @return The players' names in lexicographic order, enlisted, cold and still-mapped alike
+* @note O(k log k) for k carriers with indexes enabled, after re-indexing any players
+*       handed out by findPlayer(); otherwise a scan of every player.
+*/
+std::vector<std::string> Guild::findPlayersCarrying(const std::string& itemName) {
+    if (index_) {
+        refreshIndex();
+        return index_->findCarriers(itemName);
+    }
+
+    std::vector<std::string> carriers;
+    auto carries = [&](const Item& item) { return item.type_ != NONE && item.name_ == itemName; };
+    forEachMember(
+        [&](const Player& player) {
+            const Inventory& inventory = player.getInventoryRef();
+            bool found = inventory.getEquipped() && carries(*inventory.getEquipped());
+            for (auto cellItr = inventory.occupied().begin(); !found && cellItr != inventory.occupied().end(); ++cellItr) {
+                found = carries((*cellItr).item);
+            }
+            if (found) { carriers.push_back(player.getName()); }
+        },
+        [&](const PlayerCodec::RecordView& record) {
+            std::optional<Item> equipped = record.getEquipped();
+            bool found = equipped && carries(*equipped);
+            for (size_t cell = 0; !found && cell < record.getRows() * record.getCols(); cell++) {
+                found = carries(record.at(cell / record.getCols(), cell % record.getCols()));
+            }
+            if (found) { carriers.emplace_back(record.getName()); }
+        });
+    std::sort(carriers.begin(), carriers.end());
+    return carriers;
+}
+
+/**
+* @brief Finds the players whose Inventory::getWeight() exceeds a threshold
+* 
+* @param weight The exclusive lower bound on the players' bag weight
+* @return The players' names, heaviest first and then by name, enlisted, cold and still-mapped alike
+* @note O(k) for k matches with indexes enabled, after re-indexing any players
+*       handed out by findPlayer(); otherwise a scan of every player.
+*/
+std::vector<std::string> Guild::findPlayersHeavierThan(float weight) {
+    if (index_) {
+        refreshIndex();
+        return index_->findHeavierThan(weight);
+    }
+
+    std::vector<std::pair<float, std::string>> matches;
+    forEachMember(
+        [&](const Player& player) {
+            float carried = player.getInventoryRef().getWeight();
+            if (carried > weight) { matches.emplace_back(carried, player.getName()); }
+        },
+        [&](const PlayerCodec::RecordView& record) {
+            float carried = record.getWeight();
+            if (carried > weight) { matches.emplace_back(carried, std::string(record.getName())); }
+        });
+    std::sort(matches.begin(), matches.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
     });
+
+    std::vector<std::string> names;
+    names.reserve(matches.size());
+    for (auto& match : matches) { names.push_back(std::move(match.second)); }
+    return names;
+}
+
+/**
+* @brief Exposes the enlisted players for reading
+* @return A const reference to enlisted_players
+*/
+const std::pmr::vector<Player>& Guild::getPlayers() const {
+    return enlisted_players;
 }
 
 /**
@@ -28,11 +766,37 @@ std::vector<Player>::iterator Guild::findPlayer(const std::string& playerName) {
 *       If unsuccessful, player remains unchanged.
 */
 bool Guild::enlistPlayer(Player& player) {
-    if (findPlayer(player.getName()) != enlisted_players.end()) { return false; }
-    enlisted_players.push_back(std::move(player));
+    // A single lookup both rejects duplicates and reserves the new slot
+    if (!indexNewPlayer(player.getName())) { return false; }
+    appendNewPlayer(player.getName(), std::move(player));
+    indexPlayer(enlisted_players.back());
     return true;
 }
 
+/**
+* @brief Removes a player from this guild and hands them to the caller
+* 
+* @param playerName A const reference to the name of the player to release
+* @return The player, moved out of the guild, or std::nullopt if they are not in this guild
+* 
+* @post The player's slot is closed according to the removal policy.
+*       A player still only in the attached roster is decoded first.
+* @note The released player keeps this guild's memory resource until they join another guild.
+*/
+std::optional<Player> Guild::releasePlayer(const std::string& playerName) {
+    materializePlayer(playerName);
+    auto releasedSlotItr = player_index_.find(playerName);
+    if (releasedSlotItr == player_index_.end()) { return std::nullopt; }
+    size_t releasedSlot = releasedSlotItr->second.slot;
+
+    std::optional<Player> released(std::move(enlisted_players[releasedSlot]));
+    noteLeft(releasedSlotItr->second.joined);
+    player_index_.erase(releasedSlotItr);
+    if (index_) { index_->remove(playerName); }
+    removePlayerAt(releasedSlot);
+    return released;
+}
+
 /**
 * @brief Moves a player from this guild to another guild
 * 
@@ -47,18 +811,48 @@ bool Guild::enlistPlayer(Player& player) {
 *       If unsuccessful, both guilds remain unchanged.
 */
 bool Guild::movePlayerTo(const std::string& playerName, Guild& target) {
-    auto existingPlayerItr = target.findPlayer(playerName);
-    if (existingPlayerItr != target.enlisted_players.end()) { return false; }
+    if (target.hasPlayer(playerName)) { return false; }
 
-    auto movingPlayerItr = findPlayer(playerName);
-    if (movingPlayerItr == enlisted_players.end()) { return false; }
+    materializePlayer(playerName);
+    auto movingSlotItr = player_index_.find(playerName);
+    if (movingSlotItr == player_index_.end()) { return false; }
+    size_t movingSlot = movingSlotItr->second.slot;
 
-    target.enlisted_players.push_back(std::move(*movingPlayerItr));
-    enlisted_players.erase(movingPlayerItr);
+    target.indexNewPlayer(playerName);
+    target.appendNewPlayer(playerName, std::move(enlisted_players[movingSlot]));
+    target.indexPlayer(target.enlisted_players.back());
+
+    noteLeft(movingSlotItr->second.joined);
+    player_index_.erase(movingSlotItr);
+    if (index_) { index_->remove(playerName); }
+    removePlayerAt(movingSlot);
 
     return true;
 }
 
+/**
+* @brief Moves a player from this guild into the inbox of a guild owned by another thread
+* 
+* @param playerName A const reference to the name of the player to move
+* @param target An l-value reference to the destination guild's GuildInbox
+* @return A future holding the outcome once the target thread drains its inbox.
+*         It is ready at once, with `accepted` false and no returned player,
+*         if the player doesn't exist in this guild.
+* 
+* @post The player has left this guild before the call returns. The target guild
+*       is never touched by the calling thread; if it rejects the player because
+*       it already has their name, the player comes back in TransferOutcome::returned.
+*/
+std::future<TransferOutcome> Guild::movePlayerTo(const std::string& playerName, GuildInbox& target) {
+    std::optional<Player> moving = releasePlayer(playerName);
+    if (!moving) {
+        std::promise<TransferOutcome> missing;
+        missing.set_value(TransferOutcome{false, std::nullopt});
+        return missing.get_future();
+    }
+    return target.post(std::move(*moving));
+}
+
 /**
 * @brief Copies a player from this guild to another guild
 * 
@@ -73,12 +867,229 @@ bool Guild::movePlayerTo(const std::string& playerName, Guild& target) {
 *       In either case, the original player in this guild remains unchanged.
 */
 bool Guild::copyPlayerTo(const std::string& playerName, Guild& target) {
-    auto existingPlayerItr = target.findPlayer(playerName);
-    if (existingPlayerItr != target.enlisted_players.end()) { return false; }
+    if (target.hasPlayer(playerName)) { return false; }
 
-    auto copiedPlayerItr = findPlayer(playerName);
+    // A cold or mapped player is decoded straight into the target; this guild keeps its record
+    std::optional<PlayerCodec::RecordView> record = findColdPlayer(playerName);
+    if (!record) { record = findMappedPlayer(playerName); }
+    if (record) {
+        Player copy = record->materialize();
+        target.indexNewPlayer(playerName);
+        target.appendNewPlayer(playerName, std::move(copy));
+        target.indexPlayer(target.enlisted_players.back());
+        return true;
+    }
+
+    auto copiedPlayerItr = static_cast<const Guild&>(*this).findPlayer(playerName);
     if (copiedPlayerItr == enlisted_players.end()) { return false; }
 
-    target.enlisted_players.push_back(*copiedPlayerItr);
+    target.indexNewPlayer(playerName);
+    target.appendNewPlayer(playerName, *copiedPlayerItr);
+    target.indexPlayer(target.enlisted_players.back());
     return true;
+}
+
+/**
+* @brief Attempts to enlist a batch of players into the guild
+* 
+* @param players An l-value reference to the Player objects whose contents will be moved into the guild
+* @return A bitmap with one entry per element of `players`: true if that player was enlisted,
+*         false if a player with the same name was already in the guild or earlier in the batch
+* 
+* @post Capacity is reserved once for the whole batch, if the guild is short of room. Each enlisted player is moved
+*       into enlisted_players and left in a valid but unspecified state;
+*       rejected players remain unchanged.
+*/
+std::vector<bool> Guild::enlistPlayers(std::vector<Player>& players) {
+    std::vector<bool> enlisted(players.size(), false);
+    reserveForBatch(players.size());
+
+    for (size_t i = 0; i < players.size(); i++) {
+        enlisted[i] = enlistPlayer(players[i]);
+    }
+    return enlisted;
+}
+
+/**
+* @brief Moves a batch of players from this guild to another guild
+* 
+* @param playerNames A const reference to the names of the players to move
+* @param target An l-value reference to the destination Guild
+* @return A bitmap with one entry per element of `playerNames`: true if that player was moved,
+*         false if they are not in this guild (or were already moved earlier in the batch)
+*         or if a player with the same name already exists in the target guild
+* 
+* @post Moved players are appended to the target in batch order. Under STABLE, this guild's
+*       enlisted_players is compacted in a single pass, keeping the remaining players in order;
+*       under the other policies each removal is a swap and pop.
+*/
+std::vector<bool> Guild::movePlayersTo(const std::vector<std::string>& playerNames, Guild& target) {
+    std::vector<bool> moved(playerNames.size(), false);
+    if (&target == this) { return moved; } // Every name would already exist in the target
+
+    target.reserveForBatch(playerNames.size());
+
+    // Materialize mapped players up front, so the slots below cover every player that may move
+    for (const std::string& playerName : playerNames) {
+        if (!target.hasPlayer(playerName)) { materializePlayer(playerName); }
+    }
+
+    // Gaps are closed immediately unless the roster must keep its order
+    bool stable = removal_policy_ == RemovalPolicy::STABLE;
+
+    // Under STABLE, vacated slots are left in place and compacted afterwards
+    std::vector<bool> vacated(stable ? enlisted_players.size() : 0, false);
+    size_t firstVacated = enlisted_players.size();
+    for (size_t i = 0; i < playerNames.size(); i++) {
+        if (target.hasPlayer(playerNames[i])) { continue; }
+
+        auto movingSlotItr = player_index_.find(playerNames[i]);
+        if (movingSlotItr == player_index_.end()) { continue; }
+        size_t movingSlot = movingSlotItr->second.slot;
+
+        target.indexNewPlayer(playerNames[i]);
+        target.appendNewPlayer(playerNames[i], std::move(enlisted_players[movingSlot]));
+        target.indexPlayer(target.enlisted_players.back());
+        noteLeft(movingSlotItr->second.joined);
+        player_index_.erase(movingSlotItr);
+        if (index_) { index_->remove(playerNames[i]); }
+        moved[i] = true;
+
+        if (stable) {
+            vacated[movingSlot] = true;
+            firstVacated = std::min(firstVacated, movingSlot);
+        } else {
+            removePlayerAt(movingSlot);
+        }
+    }
+    if (!stable) { return moved; }
+
+    // Compact the remaining players in a single pass
+    size_t write = firstVacated;
+    for (size_t read = firstVacated; read < enlisted_players.size(); read++) {
+        if (vacated[read]) { continue; }
+        enlisted_players[write++] = std::move(enlisted_players[read]);
+    }
+    enlisted_players.erase(enlisted_players.begin() + write, enlisted_players.end());
+    reindexFrom(firstVacated);
+
+    return moved;
+}
+
+/**
+* @brief Copies a batch of players from this guild to another guild
+* 
+* @param playerNames A const reference to the names of the players to copy
+* @param target An l-value reference to the destination Guild
+* @return A bitmap with one entry per element of `playerNames`: true if that player was copied,
+*         false if they are not in this guild or if a player with the same name
+*         already exists in the target guild (or was copied earlier in the batch)
+* 
+* @post Copies are appended to the target in batch order. This guild remains unchanged.
+*/
+std::vector<bool> Guild::copyPlayersTo(const std::vector<std::string>& playerNames, Guild& target) {
+    std::vector<bool> copied(playerNames.size(), false);
+    target.reserveForBatch(playerNames.size());
+
+    for (size_t i = 0; i < playerNames.size(); i++) {
+        copied[i] = copyPlayerTo(playerNames[i], target);
+    }
+    return copied;
+}
+
+/**
+* @brief Computes guild-wide inventory totals
+* 
+* @param threads The number of worker threads. 0 uses std::thread::hardware_concurrency(),
+*        1 runs sequentially on the calling thread.
+* @return The players' total carried weight and bag item counts per ItemType
+* 
+* @note Players are reduced in fixed-size chunks and the chunk results are combined
+*       in roster order, so the floating-point total is identical for every `threads`.
+*       Cold players and those still only mapped are included, read in place from their records.
+*/
+GuildStats Guild::aggregate(size_t threads) const {
+    // Slots past enlisted_players address mapped_roster_ entries, then cold players
+    size_t enlisted = enlisted_players.size();
+    size_t mapped = mapped_claimed_.size();
+    std::vector<const std::vector<std::uint8_t>*> coldRecords;
+    coldRecords.reserve(cold_players_.size());
+    for (const auto& cold : cold_players_) { coldRecords.push_back(&cold.second.record); }
+    size_t slots = enlisted + mapped + coldRecords.size();
+    size_t chunkCount = (slots + AGGREGATION_CHUNK - 1) / AGGREGATION_CHUNK;
+    std::vector<GuildStats> partials(chunkCount, GuildStats{0, 0, {}});
+
+    forEachChunk(chunkCount, threads, [&](size_t chunk) {
+        GuildStats& partial = partials[chunk];
+        size_t end = std::min(slots, (chunk + 1) * AGGREGATION_CHUNK);
+        for (size_t slot = chunk * AGGREGATION_CHUNK; slot < end; slot++) {
+            if (slot < enlisted) {
+                const Inventory& inventory = enlisted_players[slot].getInventoryRef();
+                partial.player_count++;
+                partial.total_weight += inventory.getWeight();
+                for (ItemType type : {WEAPON, ACCESSORY, ARMOR}) { partial.item_counts[type] += inventory.getCount(type); }
+            } else if (slot >= enlisted + mapped || !mapped_claimed_[slot - enlisted]) {
+                PlayerCodec::RecordView record = (slot < enlisted + mapped)
+                    ? mapped_roster_->getRecord(slot - enlisted)
+                    : PlayerCodec::RecordView(coldRecords[slot - enlisted - mapped]->data(),
+                                              coldRecords[slot - enlisted - mapped]->size());
+                partial.player_count++;
+                partial.total_weight += record.getWeight();
+                std::array<size_t, 4> counts = record.countAllTypes();
+                for (ItemType type : {WEAPON, ACCESSORY, ARMOR}) { partial.item_counts[type] += counts[type]; }
+            }
+        }
+    });
+
+    GuildStats total{0, 0, {}};
+    for (const GuildStats& partial : partials) {
+        total.player_count += partial.player_count;
+        total.total_weight += partial.total_weight;
+        for (size_t type = 0; type < total.item_counts.size(); type++) {
+            total.item_counts[type] += partial.item_counts[type];
+        }
+    }
+    return total;
+}
+
+/**
+* @brief Finds the players carrying the most weight
+* 
+* @param count The maximum number of players to return
+* @param threads The number of worker threads, as in aggregate()
+* @return Iterators into getPlayers(), heaviest first. Ties are broken by roster position,
+*         so the result is identical for every `threads`.
+* @note Unlike aggregate(), only players in enlisted_players are ranked: cold players and those
+*       still only mapped have no iterator to return, so they are skipped even if heavier.
+*       Look them up first, or use findPlayersHeavierThan(), which covers the whole guild.
+*/
+std::vector<std::pmr::vector<Player>::const_iterator> Guild::getHeaviestPlayers(size_t count, size_t threads) const {
+    using Candidate = std::pair<float, size_t>; // (weight, slot)
+    auto heavierFirst = [](const Candidate& lhs, const Candidate& rhs) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+    };
+
+    // Each chunk keeps only its own top `count` candidates
+    size_t chunkCount = (enlisted_players.size() + AGGREGATION_CHUNK - 1) / AGGREGATION_CHUNK;
+    std::vector<std::vector<Candidate>> partials(chunkCount);
+    forEachChunk(chunkCount, threads, [&](size_t chunk) {
+        std::vector<Candidate>& candidates = partials[chunk];
+        size_t end = std::min(enlisted_players.size(), (chunk + 1) * AGGREGATION_CHUNK);
+        for (size_t slot = chunk * AGGREGATION_CHUNK; slot < end; slot++) {
+            candidates.emplace_back(enlisted_players[slot].getInventoryRef().getWeight(), slot);
+        }
+        size_t keep = std::min(count, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(), heavierFirst);
+        candidates.resize(keep);
+    });
+
+    std::vector<Candidate> merged;
+    for (const auto& candidates : partials) { merged.insert(merged.end(), candidates.begin(), candidates.end()); }
+    size_t keep = std::min(count, merged.size());
+    std::partial_sort(merged.begin(), merged.begin() + keep, merged.end(), heavierFirst);
+
+    std::vector<std::pmr::vector<Player>::const_iterator> heaviest;
+    heaviest.reserve(keep);
+    for (size_t i = 0; i < keep; i++) { heaviest.push_back(enlisted_players.begin() + merged[i].second); }
+    return heaviest;
 }
\ No newline at end of file
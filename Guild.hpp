@@ -1,29 +1,543 @@
 #pragma once
 
+#include "GuildIndex.hpp"
+#include "GuildInbox.hpp"
 #include "Player.hpp"
+#include "PlayerCodec.hpp"
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <future>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+class MappedRoster;
+
+/**
+* @brief How a Guild closes the gap a player leaves in enlisted_players.
+*/
+enum class RemovalPolicy {
+    STABLE,     // Erase in place: O(n) per removal, enlisted_players stays in join order
+    UNORDERED,  // Swap with the last player and pop: O(1) per removal; getPlayersByJoinTime() sorts, O(n log n)
+    JOIN_ORDER  // Swap and pop, plus an ordered join index: O(log n) per join and removal;
+                // getPlayersByJoinTime() walks the index, O(n)
+};
+
+/**
+* @brief Guild-wide totals produced by Guild::aggregate.
+*/
+struct GuildStats {
+    size_t player_count;               // The number of players aggregated
+    float total_weight;                // The sum of every player's Inventory::getWeight()
+    std::array<size_t, 4> item_counts; // Bag items per ItemType, indexed by ItemType (NONE stays 0)
+};
+
+/**
+* @brief When Guild::demoteIdlePlayers() moves players to the cold store.
+* Idleness is measured on the guild's access clock, which advances once per mutable findPlayer() call.
+*/
+struct TieringPolicy {
+    std::uint64_t max_idle;  // A player not looked up in more than this many accesses is idle
+    size_t min_hot_players;  // Demotion stops once only this many players remain enlisted
+};
+
+/**
+* @brief Lookup and demotion counters of a Guild's hot/cold tiering.
+*/
+struct TieringStats {
+    std::uint64_t hot_hits;   // Mutable lookups served without rehydrating anyone
+    std::uint64_t cold_hits;  // Cold players rehydrated, by a lookup or any other mutation
+    std::uint64_t misses;     // Mutable lookups for a name not in the guild
+    std::uint64_t demotions;  // Players moved to the cold store
+    std::uint64_t failed_demotions; // Idle players kept enlisted because their record did not round-trip
+};
 
 class Guild {
     private: 
+        /**
+        * @brief A player's position in enlisted_players and when they joined this guild.
+        */
+        struct RosterEntry {
+            size_t slot;          // The player's index in enlisted_players
+            std::uint64_t joined; // The guild's join counter when the player was added
+            std::uint64_t last_access; // The guild's access clock when the player was last looked up
+            bool index_stale;     // Handed out for mutation since index_ last read their inventory
+        };
+
+        /**
+        * @brief A player demoted out of enlisted_players by demoteIdlePlayers()
+        */
+        struct ColdPlayer {
+            std::vector<std::uint8_t> record; // The player as a PlayerCodec SNAPSHOT record
+            std::uint64_t joined;             // The player's join counter, restored on rehydration
+        };
+
         /**
         * @brief A vector containing the players currently enlisted in the guild.
+        * Allocated, with every player's inventory grid, from the guild's memory resource.
+        */
+        std::pmr::vector<Player> enlisted_players;
+
+        /**
+        * @brief Maps each enlisted player's name to its slot in enlisted_players.
+        * Kept in sync with enlisted_players by every member that adds or removes a player.
+        */
+        std::pmr::unordered_map<std::string, RosterEntry> player_index_;
+
+        /**
+        * @brief The join counter handed to the next player added to the guild.
+        */
+        std::uint64_t next_join_;
+
+        /**
+        * @brief How removals close the gap left in enlisted_players.
+        */
+        RemovalPolicy removal_policy_;
+
+        /**
+        * @brief The enlisted players' names keyed by join counter, earliest first.
+        * Maintained only under JOIN_ORDER, and empty otherwise. Cold players are not in it.
+        */
+        std::pmr::map<std::uint64_t, std::string> join_order_;
+
+        /**
+        * @brief A read-only roster file whose players belong to this guild without being decoded.
+        * nullptr unless attachRoster() was called. Shared, so copies of the guild reuse the mapping.
+        */
+        std::shared_ptr<const MappedRoster> mapped_roster_;
+
+        /**
+        * @brief One flag per mapped_roster_ entry: set once the player was materialized
+        * into enlisted_players (or left the guild), after which the mapped record is ignored.
+        */
+        std::vector<bool> mapped_claimed_;
+
+        /**
+        * @brief The number of set flags in mapped_claimed_
+        */
+        size_t mapped_claimed_count_;
+
+        /**
+        * @brief Idle players compacted into encoded records, by name. None of them is in player_index_.
+        * materializePlayer() moves a player back into enlisted_players on their next mutable access.
+        */
+        std::unordered_map<std::string, ColdPlayer> cold_players_;
+
+        /**
+        * @brief Advanced by every mutable findPlayer() call; stamped into RosterEntry::last_access
+        */
+        std::uint64_t access_clock_;
+
+        /**
+        * @brief The thresholds applied by demoteIdlePlayers()
+        */
+        TieringPolicy tiering_policy_;
+
+        /**
+        * @brief The counters reported by getTieringStats()
+        */
+        TieringStats tiering_stats_;
+
+        /**
+        * @brief The item and weight indexes, or std::nullopt unless enableIndexes() was called.
+        * Covers enlisted, cold and still-mapped players alike.
+        */
+        std::optional<GuildIndex> index_;
+
+        /**
+        * @brief The players flagged RosterEntry::index_stale, re-indexed by the next query.
+        * May also name players that have since left or been re-indexed; those are skipped.
+        */
+        std::vector<std::string> stale_players_;
+
+        /**
+        * @brief Set when every player may be stale, e.g. after getPlayersByJoinTime();
+        * the next query rebuilds index_ from scratch.
+        */
+        bool index_all_stale_;
+
+        /**
+        * @brief Finds a player that still lives only in mapped_roster_
+        * @param playerName A const reference to the player's name to search for
+        * @return The player's roster position, or std::nullopt if they are not mapped or already claimed
+        */
+        std::optional<size_t> findMappedSlot(const std::string& playerName) const;
+
+        /**
+        * @brief Decodes a cold or mapped player into enlisted_players so that it can be mutated
+        * @param playerName A const reference to the player's name
+        * @post A cold player is rehydrated with their original join time and leaves cold_players_.
+        *       Under STABLE they return to their join-order slot, otherwise they are appended.
+        *       If the player lived only in mapped_roster_, they are enlisted and their record is claimed.
+        *       Otherwise nothing changes.
         */
-        std::vector<Player> enlisted_players;
+        void materializePlayer(const std::string& playerName);
+
+        /**
+        * @brief Refreshes the slots stored in player_index_ for every player at or after `first`
+        * @param first The first slot in enlisted_players whose index entry may be stale
+        */
+        void reindexFrom(size_t first);
+
+        /**
+        * @brief Finds where a player who joined at `joined` belongs in a join-ordered enlisted_players
+        * @param joined The player's join counter
+        * @return The first slot whose player joined later, or enlisted_players.size(). O(log n).
+        */
+        size_t findJoinSlot(std::uint64_t joined) const;
+
+        /**
+        * @brief Sorts enlisted_players back into join order and refreshes every slot in player_index_
+        * @note O(n log n); each player is moved once
+        */
+        void restoreJoinOrder();
+
+        /**
+        * @brief Files a player who entered enlisted_players in join_order_, under JOIN_ORDER
+        * @param playerName A const reference to the player's name
+        * @param joined The player's join counter
+        */
+        void noteJoined(const std::string& playerName, std::uint64_t joined);
+
+        /**
+        * @brief Removes a player who is leaving enlisted_players from join_order_, under JOIN_ORDER
+        * @param joined The player's join counter
+        */
+        void noteLeft(std::uint64_t joined);
+
+        /**
+        * @brief Makes room for a batch of players about to be appended to enlisted_players
+        * @param count The number of players in the batch
+        * @note Grows only when the room is short, and then to at least twice the current capacity,
+        *       so a run of small batches still reallocates geometrically
+        */
+        void reserveForBatch(size_t count);
+
+        /**
+        * @brief Adds an index entry for a player about to be appended to enlisted_players
+        * @param playerName A const reference to the name of the incoming player
+        * @return True if the entry was added, false if the name is already enlisted, cold or still mapped
+        */
+        bool indexNewPlayer(const std::string& playerName);
+
+        /**
+        * @brief Appends a player whose entry indexNewPlayer() just added
+        * @param playerName A const reference to the name passed to indexNewPlayer()
+        * @param player The player to move (or copy) into enlisted_players
+        * @throws Whatever the append throws, after removing the entry again, so the guild is unchanged
+        */
+        void appendNewPlayer(const std::string& playerName, Player&& player);
+        void appendNewPlayer(const std::string& playerName, const Player& player);
+
+        /**
+        * @brief Removes the entry indexNewPlayer() added for a player whose append failed
+        * @param playerName A const reference to the name passed to indexNewPlayer()
+        */
+        void unindexNewPlayer(const std::string& playerName);
+
+        /**
+        * @brief Removes the player at `slot` from enlisted_players according to removal_policy_
+        * @param slot The slot to remove. Its player_index_ entry must already be erased.
+        * @post Every remaining player's index entry points at its new slot
+        */
+        void removePlayerAt(size_t slot);
+
+        /**
+        * @brief Resolves a mutable access to a player, materializing them if needed
+        * @param playerName A const reference to the player's name to search for
+        * @return The player's index entry, or nullptr if they are not in the guild
+        * @post Counts as an access for tiering, and stamps the player as active
+        */
+        RosterEntry* accessPlayer(const std::string& playerName);
+
+        /**
+        * @brief Flags a player whose inventory may change behind index_'s back
+        * @param entry The player's index entry
+        * @param playerName A const reference to the player's name
+        */
+        void markIndexStale(RosterEntry& entry, const std::string& playerName);
+
+        /**
+        * @brief Files a player appended to enlisted_players in index_, if indexing is enabled
+        * @param player A const reference to the player
+        */
+        void indexPlayer(const Player& player);
+
+        /**
+        * @brief Visits every player of the guild, enlisted, cold or still mapped, without decoding any
+        * @param visitPlayer A callable invoked as visitPlayer(const Player&) per enlisted player
+        * @param visitRecord A callable invoked as visitRecord(const PlayerCodec::RecordView&)
+        *        per cold or still-mapped player
+        */
+        template <typename PlayerVisitor, typename RecordVisitor>
+        void forEachMember(PlayerVisitor visitPlayer, RecordVisitor visitRecord) const;
+
+        /**
+        * @brief Adds every player of the guild, enlisted, cold or still mapped, to an index
+        * @param index An l-value reference to the GuildIndex to fill
+        */
+        void fillIndex(GuildIndex& index) const;
+
+        /**
+        * @brief Clears every RosterEntry::index_stale flag and the lists of stale players
+        */
+        void clearIndexStaleness();
+
+        /**
+        * @brief Re-indexes the stale players, so that index_ matches every inventory again
+        */
+        void refreshIndex();
+
+        // Both save enlisted, cold and still-mapped players alike
+        friend class MappedRoster;
+        friend class RosterStream;
+        // Reserves room for a drained batch, then enlists it one transfer at a time
+        friend class GuildInbox;
     public:
         /**
          * @brief Constructs a new Guild object. Initializes the enlisted_players vector.
+         * @param policy How removals close the gap in enlisted_players. Defaults to STABLE.
+         * @param resource The memory resource for the roster and its players' inventories,
+         *        e.g. a std::pmr::monotonic_buffer_resource per shard, so that tearing the guild down
+         *        releases one arena. It must outlive the guild. Defaults to the default resource.
+         * @note Players moved in from a guild on the same resource are moved by pointer;
+         *       from any other, their inventories are copied into this guild's resource.
+         *       A copy of the guild, like a copy of a std::pmr container, uses the default resource.
          */
-        Guild();
+        Guild(RemovalPolicy policy = RemovalPolicy::STABLE,
+              std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        /**
+        * @brief Retrieves the memory resource of enlisted_players
+        * @return The resource passed to the constructor
+        */
+        std::pmr::memory_resource* getMemoryResource() const;
+
+        /**
+        * @brief Retrieves the value stored in removal_policy_
+        * @return The RemovalPolicy this guild applies to removals
+        */
+        RemovalPolicy getRemovalPolicy() const;
+
+        /**
+        * @brief Changes how later removals close the gap in enlisted_players
+        * @param policy The RemovalPolicy to apply from now on
+        * @note Switching to STABLE from another policy sorts enlisted_players back into join order,
+        *       in O(n log n), which invalidates iterators into it. Switching to JOIN_ORDER
+        *       builds its join index, in O(n log n).
+        */
+        void setRemovalPolicy(RemovalPolicy policy);
+
+        /**
+        * @brief Lists the enlisted players ordered by when they joined this guild
+        * 
+        * @return Iterators into enlisted_players, earliest join first.
+        *         O(n) under STABLE and JOIN_ORDER, O(n log n) under UNORDERED.
+        * @note The iterators allow mutation, so with indexes enabled the next query rebuilds them.
+        *       Changes made through them after that query are missed by the indexes, so do not hold
+        *       them across findPlayersCarrying() or findPlayersHeavierThan().
+        */
+        std::vector<std::pmr::vector<Player>::iterator> getPlayersByJoinTime();
 
         /**
         * @brief Searches for a player in the guild by name
         * 
         * @param playerName A const reference to the player's name to search for
-        * @return std::vector<Player>::iterator An iterator pointing to the found player, or enlisted_players.end() if not found
+        * @return std::pmr::vector<Player>::iterator An iterator pointing to the found player, or enlisted_players.end() if not found
+        * @note Average O(1): resolved through player_index_ rather than a scan of enlisted_players.
+        *       A cold or still-mapped player is materialized first, since the iterator allows mutation.
+        *       Counts as an access for tiering, and stamps the player as active.
+        *       With indexes enabled, the player is re-indexed by the next query;
+        *       prefer modifyPlayer() to re-index them at once. Changes made through the
+        *       iterator after that query are missed by the indexes, so do not hold it across queries.
+        */
+        std::pmr::vector<Player>::iterator findPlayer(const std::string& playerName);
+
+        /**
+        * @brief Searches for a player in the guild by name without allowing modification
+        * 
+        * @param playerName A const reference to the player's name to search for
+        * @return std::pmr::vector<Player>::const_iterator An iterator pointing to the found player, or getPlayers().end() if not found
+        * @note Never materializes a cold or mapped player; use findColdPlayer() or findMappedPlayer()
+        *       to read one in place. Not counted as an access for tiering.
+        */
+        std::pmr::vector<Player>::const_iterator findPlayer(const std::string& playerName) const;
+
+        /**
+        * @brief Checks whether a player with the given name is enlisted
+        * @param playerName A const reference to the player's name to search for
+        * @return True if the player is in the guild, enlisted, cold or still mapped, false otherwise
+        */
+        bool hasPlayer(const std::string& playerName) const;
+
+        /**
+        * @brief Retrieves the number of players in the guild
+        * @return The size of enlisted_players plus the cold players and those that are still only mapped
+        */
+        size_t getPlayerCount() const;
+
+        /**
+        * @brief Attaches a read-only roster file whose players join this guild without being decoded
+        * 
+        * @param roster A shared pointer to the opened MappedRoster
+        * @post Every player in the file counts as enlisted. Players already in enlisted_players
+        *       or the cold store take precedence over a mapped record with the same name.
+        *       Any previously attached roster is replaced and its unclaimed players are dropped.
+        * @note O(enlisted players * log(roster size)); the file itself is not read.
+        */
+        void attachRoster(std::shared_ptr<const MappedRoster> roster);
+
+        /**
+        * @brief Retrieves the number of players that are still only mapped
+        * @return The number of mapped_roster_ entries not yet materialized, or 0 without a roster
+        */
+        size_t getMappedPlayerCount() const;
+
+        /**
+        * @brief Reads a player that has not been materialized, in place
+        * 
+        * @param playerName A const reference to the player's name to search for
+        * @return A view of the player's mapped record, or std::nullopt if the player is not mapped
+        *         or already lives in enlisted_players
         */
-        std::vector<Player>::iterator findPlayer(const std::string& playerName);
+        std::optional<PlayerCodec::RecordView> findMappedPlayer(const std::string& playerName) const;
+
+        /**
+        * @brief Saves every player of the guild to a roster file that attachRoster() can map
+        * @param path The file to create or replace
+        * @throws std::system_error If the file cannot be written
+        */
+        void saveRoster(const std::string& path) const;
+
+        /**
+        * @brief Retrieves the value stored in tiering_policy_
+        * @return The thresholds demoteIdlePlayers() applies
+        */
+        TieringPolicy getTieringPolicy() const;
+
+        /**
+        * @brief Changes the thresholds demoteIdlePlayers() applies
+        * @param policy The TieringPolicy to apply from the next sweep on.
+        *        The default policy, with an unlimited max_idle, never demotes anyone.
+        */
+        void setTieringPolicy(const TieringPolicy& policy);
+
+        /**
+        * @brief Compacts idle players out of enlisted_players into the cold store
+        * 
+        * @return The number of players demoted
+        * 
+        * @post Every enlisted player idle for more than max_idle accesses is encoded as a
+        *       PlayerCodec record, keyed by name, until min_hot_players remain enlisted.
+        *       The remaining players keep their order. They still count as members, and their
+        *       next mutable access (findPlayer, movePlayerTo, ...) rehydrates them with a move.
+        *       The roster's spare capacity is released once it holds a quarter of it or less.
+        *       A player whose record fails to encode or decode back stays enlisted, and is
+        *       counted in TieringStats::failed_demotions.
+        * @note O(n) in enlisted players, plus one decode per demoted player to validate their record;
+        *       call it from the game loop, not per lookup.
+        */
+        size_t demoteIdlePlayers();
+
+        /**
+        * @brief Retrieves the number of players in the cold store
+        * @return The size of cold_players_
+        */
+        size_t getColdPlayerCount() const;
+
+        /**
+        * @brief Reads a cold player in place, without rehydrating them
+        * 
+        * @param playerName A const reference to the player's name to search for
+        * @return A view of the player's encoded record, or std::nullopt if the player is not cold.
+        *         The view is invalidated when the player is rehydrated.
+        */
+        std::optional<PlayerCodec::RecordView> findColdPlayer(const std::string& playerName) const;
+
+        /**
+        * @brief Retrieves the value stored in tiering_stats_
+        * @return The lookup and demotion counters since the guild was constructed
+        */
+        TieringStats getTieringStats() const;
+
+        /**
+        * @brief Starts maintaining the item and weight indexes used by findPlayersCarrying()
+        *        and findPlayersHeavierThan()
+        * @post Every player, enlisted, cold or still mapped, is indexed. From now on enlisting,
+        *       moving, copying, releasing and modifyPlayer() keep the indexes in step.
+        * @note O(items in the guild). Does nothing if indexing is already enabled.
+        */
+        void enableIndexes();
+
+        /**
+        * @brief Stops maintaining the indexes and releases their memory
+        * @post Queries fall back to scanning every player
+        */
+        void disableIndexes();
+
+        /**
+        * @brief Checks whether the indexes are maintained
+        * @return True between enableIndexes() and disableIndexes(), false otherwise
+        */
+        bool hasIndexes() const;
+
+        /**
+        * @brief Runs a mutating callback on a player and re-indexes them immediately
+        * 
+        * @param playerName A const reference to the player's name to search for
+        * @param modify A callable invoked as modify(Player&) if the player exists.
+        *        It must not rename the player or add and remove guild members.
+        * @return True if the player was found and modified, false otherwise
+        * @note Materializes a cold or mapped player and counts as an access, like findPlayer().
+        *       If `modify` throws, the player is re-indexed by the next query instead.
+        */
+        template <typename Mutator>
+        bool modifyPlayer(const std::string& playerName, Mutator modify) {
+            RosterEntry* entry = accessPlayer(playerName);
+            if (!entry) { return false; }
+            Player& player = enlisted_players[entry->slot];
+            try {
+                modify(player);
+            } catch (...) {
+                markIndexStale(*entry, playerName);
+                throw;
+            }
+            indexPlayer(player);
+            return true;
+        }
+
+        /**
+        * @brief Finds the players carrying an item, in the bag or equipped
+        * 
+        * @param itemName A const reference to the item name to search for
+        * @return The players' names in lexicographic order, enlisted, cold and still-mapped alike
+        * @note O(k log k) for k carriers with indexes enabled, after re-indexing any players
+        *       handed out by findPlayer(); otherwise a scan of every player.
+        */
+        std::vector<std::string> findPlayersCarrying(const std::string& itemName);
+
+        /**
+        * @brief Finds the players whose Inventory::getWeight() exceeds a threshold
+        * 
+        * @param weight The exclusive lower bound on the players' bag weight
+        * @return The players' names, heaviest first and then by name, enlisted, cold and still-mapped alike
+        * @note O(k) for k matches with indexes enabled, after re-indexing any players
+        *       handed out by findPlayer(); otherwise a scan of every player.
+        */
+        std::vector<std::string> findPlayersHeavierThan(float weight);
+
+        /**
+        * @brief Exposes the enlisted players for reading
+        * @return A const reference to enlisted_players
+        */
+        const std::pmr::vector<Player>& getPlayers() const;
 
         /**
         * @brief Attempts to enlist a player into the guild
@@ -37,6 +551,18 @@ class Guild {
         */
         bool enlistPlayer(Player& player);
 
+        /**
+        * @brief Removes a player from this guild and hands them to the caller
+        * 
+        * @param playerName A const reference to the name of the player to release
+        * @return The player, moved out of the guild, or std::nullopt if they are not in this guild
+        * 
+        * @post The player's slot is closed according to the removal policy.
+        *       A player still only in the attached roster is decoded first.
+        * @note The released player keeps this guild's memory resource until they join another guild.
+        */
+        std::optional<Player> releasePlayer(const std::string& playerName);
+
         /**
         * @brief Moves a player from this guild to another guild
         * 
@@ -52,6 +578,22 @@ class Guild {
         */
         bool movePlayerTo(const std::string& playerName, Guild& target);
 
+
+        /**
+        * @brief Moves a player from this guild into the inbox of a guild owned by another thread
+        * 
+        * @param playerName A const reference to the name of the player to move
+        * @param target An l-value reference to the destination guild's GuildInbox
+        * @return A future holding the outcome once the target thread drains its inbox.
+        *         It is ready at once, with `accepted` false and no returned player,
+        *         if the player doesn't exist in this guild.
+        * 
+        * @post The player has left this guild before the call returns. The target guild
+        *       is never touched by the calling thread; if it rejects the player because
+        *       it already has their name, the player comes back in TransferOutcome::returned.
+        */
+        std::future<TransferOutcome> movePlayerTo(const std::string& playerName, GuildInbox& target);
+
         /**
         * @brief Copies a player from this guild to another guild
         * 
@@ -66,4 +608,71 @@ class Guild {
         *       In either case, the original player in this guild remains unchanged.
         */
         bool copyPlayerTo(const std::string& playerName, Guild& target);
+
+        /**
+        * @brief Attempts to enlist a batch of players into the guild
+        * 
+        * @param players An l-value reference to the Player objects whose contents will be moved into the guild
+        * @return A bitmap with one entry per element of `players`: true if that player was enlisted,
+        *         false if a player with the same name was already in the guild or earlier in the batch
+        * 
+        * @post Capacity is reserved once for the whole batch. Each enlisted player is moved
+        *       into enlisted_players and left in a valid but unspecified state;
+        *       rejected players remain unchanged.
+        */
+        std::vector<bool> enlistPlayers(std::vector<Player>& players);
+
+        /**
+        * @brief Moves a batch of players from this guild to another guild
+        * 
+        * @param playerNames A const reference to the names of the players to move
+        * @param target An l-value reference to the destination Guild
+        * @return A bitmap with one entry per element of `playerNames`: true if that player was moved,
+        *         false if they are not in this guild (or were already moved earlier in the batch)
+        *         or if a player with the same name already exists in the target guild
+        * 
+        * @post Moved players are appended to the target in batch order. Under STABLE, this guild's
+        *       enlisted_players is compacted in a single pass, keeping the remaining players in order;
+        *       under the other policies each removal is a swap and pop.
+        */
+        std::vector<bool> movePlayersTo(const std::vector<std::string>& playerNames, Guild& target);
+
+        /**
+        * @brief Copies a batch of players from this guild to another guild
+        * 
+        * @param playerNames A const reference to the names of the players to copy
+        * @param target An l-value reference to the destination Guild
+        * @return A bitmap with one entry per element of `playerNames`: true if that player was copied,
+        *         false if they are not in this guild or if a player with the same name
+        *         already exists in the target guild (or was copied earlier in the batch)
+        * 
+        * @post Copies are appended to the target in batch order. This guild remains unchanged.
+        */
+        std::vector<bool> copyPlayersTo(const std::vector<std::string>& playerNames, Guild& target);
+
+        /**
+        * @brief Computes guild-wide inventory totals
+        * 
+        * @param threads The number of worker threads. 0 uses std::thread::hardware_concurrency(),
+        *        1 runs sequentially on the calling thread.
+        * @return The players' total carried weight and bag item counts per ItemType
+        * 
+        * @note Players are reduced in fixed-size chunks and the chunk results are combined
+        *       in roster order, so the floating-point total is identical for every `threads`.
+        *       Cold players and those still only mapped are included, read in place from their records.
+        */
+        GuildStats aggregate(size_t threads = 0) const;
+
+        /**
+        * @brief Finds the players carrying the most weight
+        * 
+        * @param count The maximum number of players to return
+        * @param threads The number of worker threads, as in aggregate()
+        * @return Iterators into getPlayers(), heaviest first. Ties are broken by roster position,
+        *         so the result is identical for every `threads`.
+        * @note Unlike aggregate(), only players in enlisted_players are ranked: cold players and those
+        *       still only mapped have no iterator to return, so they are skipped even if heavier.
+        *       Look them up first, or use findPlayersHeavierThan(), which covers the whole guild.
+        */
+        std::vector<std::pmr::vector<Player>::const_iterator> getHeaviestPlayers(size_t count, size_t threads = 0) const;
 };
\ No newline at end of file
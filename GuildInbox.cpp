@@ -0,0 +1,142 @@
+#include "GuildInbox.hpp"
+#include "Guild.hpp"
+#include <vector>
+
+/**
+* @brief Constructs an empty inbox.
+*/
+GuildInbox::GuildInbox() : head_(&stub_), tail_(&stub_), stub_{{nullptr}} {}
+
+/**
+* @brief Hands every undrained player back, as if the target had rejected them.
+* NOTE: No thread may post while the inbox is being destroyed.
+*/
+GuildInbox::~GuildInbox() {
+    while (Transfer* transfer = pop()) {
+        complete(transfer, TransferOutcome{false, std::move(transfer->player)});
+    }
+}
+
+/**
+* @brief Appends a link at the head of the queue.
+* @param link The link to append; its `next` must be nullptr.
+*/
+void GuildInbox::push(Link* link) noexcept {
+    // The release half publishes the transfer's contents to the consumer
+    Link* previous = head_.exchange(link, std::memory_order_acq_rel);
+    previous->next.store(link, std::memory_order_release);
+}
+
+/**
+* @brief Removes the oldest transfer.
+* @return The transfer, or nullptr if the queue is empty or a producer is mid-push.
+*/
+GuildInbox::Transfer* GuildInbox::pop() noexcept {
+    Link* tail = tail_;
+    Link* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+        if (!next) { return nullptr; }
+        tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        tail_ = next;
+        return static_cast<Transfer*>(tail);
+    }
+    // `tail` looks last; unless a producer has exchanged in after it, re-queue the stub behind it
+    if (tail != head_.load(std::memory_order_acquire)) { return nullptr; }
+    stub_.next.store(nullptr, std::memory_order_relaxed);
+    push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        tail_ = next;
+        return static_cast<Transfer*>(tail);
+    }
+    return nullptr;
+}
+
+/**
+* @brief Completes a transfer and frees it.
+* @param transfer The popped transfer.
+* @param outcome The result to report through its callback or future.
+*/
+void GuildInbox::complete(Transfer* transfer, TransferOutcome&& outcome) {
+    if (transfer->callback) {
+        transfer->callback(std::move(outcome));
+    } else {
+        transfer->completion.set_value(std::move(outcome));
+    }
+    delete transfer;
+}
+
+/**
+* @brief Queues a player for the target guild. Safe to call from any thread.
+* @param player An r-value ref. to the Player to transfer, moved into the queue.
+* @return A future that becomes ready once the target thread drains the transfer.
+*/
+std::future<TransferOutcome> GuildInbox::post(Player&& player) {
+    Transfer* transfer = new Transfer(std::move(player));
+    std::future<TransferOutcome> outcome = transfer->completion.get_future();
+    push(transfer);
+    return outcome;
+}
+
+/**
+* @brief Queues a player for the target guild. Safe to call from any thread.
+* @param player An r-value ref. to the Player to transfer, moved into the queue.
+* @param onComplete Called with the outcome on the draining thread. It must not throw.
+*/
+void GuildInbox::post(Player&& player, std::function<void(TransferOutcome&&)> onComplete) {
+    Transfer* transfer = new Transfer(std::move(player));
+    transfer->callback = std::move(onComplete);
+    push(transfer);
+}
+
+/**
+* @brief Enlists queued players into the guild that owns this inbox.
+* @param owner An l-value ref. to the target Guild. Call only from the thread that owns it.
+* @param maxBatch The most transfers to take in this call. Defaults to DEFAULT_BATCH.
+* @return The number of players enlisted.
+* @post Each drained transfer is completed: enlisted, or handed back in
+*  TransferOutcome::returned if `owner` already had their name.
+* @throws Whatever enlisting throws (e.g. std::bad_alloc), after every drained transfer not yet
+*  completed is handed back as rejected, so no future is left waiting.
+*/
+size_t GuildInbox::drain(Guild& owner, size_t maxBatch) {
+    std::vector<Transfer*> transfers;
+    size_t next = 0; // The first drained transfer not yet completed
+    try {
+        while (transfers.size() < maxBatch) {
+            Transfer* transfer = pop();
+            if (!transfer) { break; }
+            try {
+                transfers.push_back(transfer);
+            } catch (...) {
+                complete(transfer, TransferOutcome{false, std::move(transfer->player)});
+                throw;
+            }
+        }
+        if (transfers.empty()) { return 0; }
+
+        // Reserve once, so the roster grows once per batch
+        owner.reserveForBatch(transfers.size());
+        size_t enlisted = 0;
+        for (; next < transfers.size(); next++) {
+            // A throwing enlistPlayer leaves the player unchanged, ready to be handed back
+            Transfer* transfer = transfers[next];
+            if (owner.enlistPlayer(transfer->player)) {
+                enlisted++;
+                complete(transfer, TransferOutcome{true, std::nullopt});
+            } else {
+                complete(transfer, TransferOutcome{false, std::move(transfer->player)});
+            }
+        }
+        return enlisted;
+    } catch (...) {
+        for (; next < transfers.size(); next++) {
+            complete(transfers[next], TransferOutcome{false, std::move(transfers[next]->player)});
+        }
+        throw;
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <optional>
+#include "Player.hpp"
+
+class Guild;
+
+/**
+* @brief How an asynchronous transfer into a GuildInbox ended.
+*/
+struct TransferOutcome {
+    bool accepted;                  // True if the target guild enlisted the player
+    std::optional<Player> returned; // The player handed back when the target already had their name
+};
+
+/** A lock-free multi-producer, single-consumer queue of players moving into one guild.
+*
+* Any thread may `post` a player; only the thread that owns the target Guild may
+* `drain`, which enlists the queued players in one batch and then completes each
+* transfer. Producers never touch the target's `enlisted_players`, and posting is
+* a single atomic exchange, so guilds owned by different threads exchange players
+* without a lock on either roster.
+*
+* The queue is intrusive (Vyukov's MPSC design): each transfer is one heap node
+* that holds the moved Player, so a transfer moves the player twice and never copies it.
+*/
+class GuildInbox {
+    private:
+        // The queue link shared by transfers and the stub node
+        struct Link {
+            std::atomic<Link*> next;
+        };
+
+        // One queued player and how to report the result
+        struct Transfer : Link {
+            Player player;
+            std::promise<TransferOutcome> completion;             // Used when `callback` is empty
+            std::function<void(TransferOutcome&&)> callback;      // Run on the draining thread
+
+            Transfer(Player&& moving) : Link{{nullptr}}, player(std::move(moving)) {}
+        };
+
+        // The most recently posted link; producers exchange themselves in here
+        std::atomic<Link*> head_;
+
+        // The oldest link not yet drained; touched by the consumer only
+        Link* tail_;
+
+        // The placeholder that keeps the queue non-empty
+        Link stub_;
+
+        /**
+         * @brief Appends a link at the head of the queue.
+         * @param link The link to append; its `next` must be nullptr.
+         */
+        void push(Link* link) noexcept;
+
+        /**
+         * @brief Removes the oldest transfer.
+         * @return The transfer, or nullptr if the queue is empty or a producer is mid-push.
+         */
+        Transfer* pop() noexcept;
+
+        /**
+         * @brief Completes a transfer and frees it.
+         * @param transfer The popped transfer.
+         * @param outcome The result to report through its callback or future.
+         */
+        static void complete(Transfer* transfer, TransferOutcome&& outcome);
+
+    public:
+        // The transfers drain() enlists per call, if none provided
+        static constexpr size_t DEFAULT_BATCH = 256;
+
+        /**
+         * @brief Constructs an empty inbox.
+         */
+        GuildInbox();
+
+        /**
+         * @brief Hands every undrained player back, as if the target had rejected them.
+         * NOTE: No thread may post while the inbox is being destroyed.
+         */
+        ~GuildInbox();
+
+        GuildInbox(const GuildInbox&) = delete;
+        GuildInbox& operator=(const GuildInbox&) = delete;
+
+        /**
+         * @brief Queues a player for the target guild. Safe to call from any thread.
+         * @param player An r-value ref. to the Player to transfer, moved into the queue.
+         * @return A future that becomes ready once the target thread drains the transfer.
+         */
+        std::future<TransferOutcome> post(Player&& player);
+
+        /**
+         * @brief Queues a player for the target guild. Safe to call from any thread.
+         * @param player An r-value ref. to the Player to transfer, moved into the queue.
+         * @param onComplete Called with the outcome on the draining thread. It must not throw.
+         */
+        void post(Player&& player, std::function<void(TransferOutcome&&)> onComplete);
+
+        /**
+         * @brief Enlists queued players into the guild that owns this inbox.
+         * @param owner An l-value ref. to the target Guild. Call only from the thread that owns it.
+         * @param maxBatch The most transfers to take in this call. Defaults to DEFAULT_BATCH.
+         * @return The number of players enlisted.
+         * @post Each drained transfer is completed: enlisted, or handed back in
+         *  TransferOutcome::returned if `owner` already had their name.
+         * @throws Whatever enlisting throws (e.g. std::bad_alloc), after every drained transfer not yet
+         *  completed is handed back as rejected, so no future is left waiting.
+         */
+        size_t drain(Guild& owner, size_t maxBatch = DEFAULT_BATCH);
+};
@@ -0,0 +1,111 @@
+#include "GuildIndex.hpp"
+#include <algorithm>
+
+/**
+* @brief Files a member, replacing whatever was filed under their name before.
+* @param playerName The member's name.
+* @param weight The member's Inventory::getWeight().
+* @param itemNames The names of every item they carry; duplicates are allowed.
+*/
+void GuildIndex::insert(const std::string& playerName, float weight, std::vector<std::string>&& itemNames) {
+    remove(playerName);
+    std::sort(itemNames.begin(), itemNames.end());
+    itemNames.erase(std::unique(itemNames.begin(), itemNames.end()), itemNames.end());
+
+    for (const std::string& itemName : itemNames) { carriers_[itemName].insert(playerName); }
+    by_weight_.emplace(weight, playerName);
+    members_.emplace(playerName, IndexedMember{weight, std::move(itemNames)});
+}
+
+/**
+* @brief Indexes a member from their inventory, replacing any earlier entry.
+* @param playerName A const reference to the member's name.
+* @param inventory A const reference to the member's Inventory.
+*/
+void GuildIndex::add(const std::string& playerName, const Inventory& inventory) {
+    std::vector<std::string> itemNames;
+    itemNames.reserve(inventory.getCount() + 1);
+    for (const OccupiedCell& cell : inventory.occupied()) { itemNames.push_back(cell.item.name_); }
+    if (inventory.getEquipped()) { itemNames.push_back(inventory.getEquipped()->name_); }
+    insert(playerName, inventory.getWeight(), std::move(itemNames));
+}
+
+/**
+* @brief Indexes a member from an encoded record, replacing any earlier entry.
+* @param record A view of the member's SNAPSHOT record.
+*/
+void GuildIndex::add(const PlayerCodec::RecordView& record) {
+    std::vector<std::string> itemNames;
+    itemNames.reserve(record.getCount() + 1);
+    for (size_t row = 0; row < record.getRows(); row++) {
+        for (size_t col = 0; col < record.getCols(); col++) {
+            Item item = record.at(row, col);
+            if (item.type_ != NONE) { itemNames.push_back(std::move(item.name_)); }
+        }
+    }
+    std::optional<Item> equipped = record.getEquipped();
+    if (equipped) { itemNames.push_back(std::move(equipped->name_)); }
+    insert(std::string(record.getName()), record.getWeight(), std::move(itemNames));
+}
+
+/**
+* @brief Removes a member from every index.
+* @param playerName A const reference to the member's name.
+* @return True if the member was indexed, false otherwise.
+*/
+bool GuildIndex::remove(const std::string& playerName) {
+    auto memberItr = members_.find(playerName);
+    if (memberItr == members_.end()) { return false; }
+
+    for (const std::string& itemName : memberItr->second.item_names) {
+        auto carriersItr = carriers_.find(itemName);
+        carriersItr->second.erase(playerName);
+        if (carriersItr->second.empty()) { carriers_.erase(carriersItr); }
+    }
+    by_weight_.erase(std::make_pair(memberItr->second.weight, playerName));
+    members_.erase(memberItr);
+    return true;
+}
+
+/**
+* @brief Removes every member.
+*/
+void GuildIndex::clear() {
+    members_.clear();
+    carriers_.clear();
+    by_weight_.clear();
+}
+
+/**
+* @brief Retrieves the number of indexed members
+* @return The size of `members_`
+*/
+size_t GuildIndex::getSize() const {
+    return members_.size();
+}
+
+/**
+* @brief Finds the members carrying an item, in the bag or equipped.
+* @param itemName A const reference to the item name to look up.
+* @return Their names in lexicographic order. O(k log k) for k carriers.
+*/
+std::vector<std::string> GuildIndex::findCarriers(const std::string& itemName) const {
+    auto carriersItr = carriers_.find(itemName);
+    if (carriersItr == carriers_.end()) { return {}; }
+    std::vector<std::string> names(carriersItr->second.begin(), carriersItr->second.end());
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+/**
+* @brief Finds the members whose inventory weighs more than a threshold.
+* @param weight The exclusive lower bound on Inventory::getWeight().
+* @return Their names, heaviest first and then by name. O(k) for k matches.
+*/
+std::vector<std::string> GuildIndex::findHeavierThan(float weight) const {
+    std::vector<std::string> names;
+    for (auto entryItr = by_weight_.begin(); entryItr != by_weight_.end() && entryItr->first > weight; ++entryItr) {
+        names.push_back(entryItr->second);
+    }
+    return names;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Inventory.hpp"
+#include "PlayerCodec.hpp"
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/** Secondary indexes over a guild's members for item and weight queries.
+*
+* Every member is filed under their name: once per distinct item name they carry,
+* in the bag or equipped, and once in a set ordered by Inventory::getWeight().
+* Queries then visit only the matching members instead of every cell of every player.
+*
+* The index remembers what it filed for each member, so re-indexing one member
+* costs O(their distinct item names + log n), independent of the guild's size.
+* It holds names only; Guild decides when a member must be re-indexed.
+*/
+class GuildIndex {
+    private:
+        // What was filed for one member, so their entries can be removed again
+        struct IndexedMember {
+            float weight;                        // The key of their by_weight_ entry
+            std::vector<std::string> item_names; // Their distinct item names, sorted
+        };
+
+        // Orders (weight, name) pairs heaviest first, then by name
+        struct HeavierFirst {
+            bool operator()(const std::pair<float, std::string>& lhs, const std::pair<float, std::string>& rhs) const {
+                return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+            }
+        };
+
+        // Every indexed member, by name
+        std::unordered_map<std::string, IndexedMember> members_;
+
+        // The names of the members carrying each item name
+        std::unordered_map<std::string, std::unordered_set<std::string>> carriers_;
+
+        // Every member's (weight, name), heaviest first
+        std::set<std::pair<float, std::string>, HeavierFirst> by_weight_;
+
+        /**
+         * @brief Files a member, replacing whatever was filed under their name before.
+         * @param playerName The member's name.
+         * @param weight The member's Inventory::getWeight().
+         * @param itemNames The names of every item they carry; duplicates are allowed.
+         */
+        void insert(const std::string& playerName, float weight, std::vector<std::string>&& itemNames);
+    public:
+        /**
+         * @brief Indexes a member from their inventory, replacing any earlier entry.
+         * @param playerName A const reference to the member's name.
+         * @param inventory A const reference to the member's Inventory.
+         */
+        void add(const std::string& playerName, const Inventory& inventory);
+
+        /**
+         * @brief Indexes a member from an encoded record, replacing any earlier entry.
+         * @param record A view of the member's SNAPSHOT record.
+         */
+        void add(const PlayerCodec::RecordView& record);
+
+        /**
+         * @brief Removes a member from every index.
+         * @param playerName A const reference to the member's name.
+         * @return True if the member was indexed, false otherwise.
+         */
+        bool remove(const std::string& playerName);
+
+        /**
+         * @brief Removes every member.
+         */
+        void clear();
+
+        /**
+         * @brief Retrieves the number of indexed members
+         * @return The size of `members_`
+         */
+        size_t getSize() const;
+
+        /**
+         * @brief Finds the members carrying an item, in the bag or equipped.
+         * @param itemName A const reference to the item name to look up.
+         * @return Their names in lexicographic order. O(k log k) for k carriers.
+         */
+        std::vector<std::string> findCarriers(const std::string& itemName) const;
+
+        /**
+         * @brief Finds the members whose inventory weighs more than a threshold.
+         * @param weight The exclusive lower bound on Inventory::getWeight().
+         * @return Their names, heaviest first and then by name. O(k) for k matches.
+         */
+        std::vector<std::string> findHeavierThan(float weight) const;
+};
@@ -0,0 +1,167 @@
+#include "Instrumentation.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+static const char* const COUNTER_NAMES[Instrumentation::COUNTER_COUNT] = {
+    "item.constructed", "item.copy_constructed", "item.move_constructed",
+    "item.copy_assigned", "item.move_assigned", "item.destroyed",
+    "inventory.constructed", "inventory.copy_constructed", "inventory.move_constructed",
+    "inventory.copy_assigned", "inventory.move_assigned", "inventory.destroyed",
+    "player.constructed", "player.copy_constructed", "player.move_constructed",
+    "player.copy_assigned", "player.move_assigned", "player.destroyed",
+    "equipped.allocated", "equipped.freed",
+    "grid.copies", "grid.bytes_copied",
+};
+
+/**
+* @brief Retrieves one counter.
+* @param counter The counter to read.
+* @return Its total when the snapshot was taken.
+*/
+std::uint64_t Instrumentation::Snapshot::get(Counter counter) const {
+    return values[counter];
+}
+
+/**
+* @brief Subtracts an earlier snapshot, giving the events in between.
+* @param earlier A snapshot taken before this one.
+* @return A Snapshot holding the per-counter differences.
+*/
+Instrumentation::Snapshot Instrumentation::Snapshot::since(const Snapshot& earlier) const {
+    Snapshot difference;
+    for (size_t counter = 0; counter < COUNTER_COUNT; counter++) {
+        difference.values[counter] = values[counter] - earlier.values[counter];
+    }
+    return difference;
+}
+
+/**
+* @brief Names a counter for export, e.g. "item.copy_constructed".
+* @param counter The counter to name.
+* @return A static, dot-separated lowercase name.
+*/
+const char* Instrumentation::getName(Counter counter) {
+    return COUNTER_NAMES[counter];
+}
+
+#ifdef MMORPG_INSTRUMENT
+
+using CounterArray = std::array<std::atomic<std::uint64_t>, Instrumentation::COUNTER_COUNT>;
+
+/**
+ * @brief Every thread's counters, plus the totals of threads that have exited.
+ * Intentionally leaked, so threads exiting during static destruction can still fold into it.
+ */
+struct CounterRegistry {
+    std::mutex mutex;
+    std::vector<CounterArray*> live;
+    CounterArray retired{};
+};
+
+static CounterRegistry& registry() noexcept {
+    // Built in static storage rather than with `new`, so reaching the registry never throws
+    alignas(CounterRegistry) static unsigned char storage[sizeof(CounterRegistry)];
+    static CounterRegistry* instance = ::new (storage) CounterRegistry();
+    return *instance;
+}
+
+/**
+ * @brief Whether the calling thread's counters have been destroyed.
+ * A trivially destructible thread_local, so it stays readable after the counters are gone.
+ */
+static thread_local bool counters_destroyed = false;
+
+/**
+ * @brief One thread's counters, registered for its lifetime.
+ * Only the owning thread writes them; `snapshot` reads them concurrently.
+ */
+struct ThreadCounters {
+    CounterArray values{};
+    bool registered = false; // False if registering failed; the thread then counts into `retired`
+
+    // Constructed from the noexcept `recordLocal`, so a failed registration must not throw
+    ThreadCounters() noexcept {
+        try {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            registry().live.push_back(&values);
+            registered = true;
+        } catch (...) {
+            // Out of memory or the lock failed: `recordLocal` falls back to `retired`
+        }
+    }
+
+    ~ThreadCounters() {
+        if (!registered) {
+            counters_destroyed = true;
+            return;
+        }
+        CounterRegistry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for (size_t counter = 0; counter < values.size(); counter++) {
+            shared.retired[counter].fetch_add(values[counter].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        shared.live.erase(std::find(shared.live.begin(), shared.live.end(), &values));
+        counters_destroyed = true;
+    }
+};
+
+/**
+* @brief Adds to the calling thread's counter, or to the exited-thread
+*  totals once the thread's counters have been destroyed.
+* @note A thread whose counters could not be registered also adds to the exited-thread totals.
+*/
+void Instrumentation::recordLocal(Counter counter, std::uint64_t amount) noexcept {
+    if (counters_destroyed) {
+        registry().retired[counter].fetch_add(amount, std::memory_order_relaxed);
+        return;
+    }
+    thread_local ThreadCounters local;
+    if (!local.registered) {
+        registry().retired[counter].fetch_add(amount, std::memory_order_relaxed);
+        return;
+    }
+    // Single writer, so a plain load and store is enough; atomic only for `snapshot`
+    std::atomic<std::uint64_t>& value = local.values[counter];
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/**
+* @brief Sums the counters of every thread, including exited ones.
+* @return The current totals; all zero when instrumentation is compiled out.
+* @note Takes a lock shared with thread start-up and exit, never with `record`.
+*/
+Instrumentation::Snapshot Instrumentation::snapshot() {
+    CounterRegistry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    Snapshot totals;
+    for (size_t counter = 0; counter < COUNTER_COUNT; counter++) {
+        std::uint64_t total = shared.retired[counter].load(std::memory_order_relaxed);
+        for (const CounterArray* thread : shared.live) { total += (*thread)[counter].load(std::memory_order_relaxed); }
+        totals.values[counter] = total;
+    }
+    return totals;
+}
+
+#else
+
+/**
+* @brief Adds to the calling thread's counter, or to the exited-thread
+*  totals once the thread's counters have been destroyed.
+*/
+void Instrumentation::recordLocal(Counter, std::uint64_t) noexcept {}
+
+/**
+* @brief Sums the counters of every thread, including exited ones.
+* @return The current totals; all zero when instrumentation is compiled out.
+* @note Takes a lock shared with thread start-up and exit, never with `record`.
+*/
+Instrumentation::Snapshot Instrumentation::snapshot() {
+    Snapshot totals;
+    totals.values.fill(0);
+    return totals;
+}
+
+#endif
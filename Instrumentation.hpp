@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/** Opt-in counters for object lifecycles, equipped-item allocations and grid copies.
+*
+* Counting is compiled in only when MMORPG_INSTRUMENT is defined (`make INSTRUMENT=1`).
+* Otherwise `record` is an empty inline function and CountedInstance is an empty base,
+* so instrumented code compiles to exactly what it would be without the calls.
+*
+* Each thread bumps its own counters without synchronization beyond a relaxed store;
+* `snapshot` sums every live thread plus the totals of threads that have exited.
+*
+* Inventory and Player copy-assign by copy constructing a temporary and move
+* assigning it, so each copy assignment also counts one of each (and a destruction).
+*/
+class Instrumentation {
+    public:
+        // True when the counters are compiled in
+#ifdef MMORPG_INSTRUMENT
+        static constexpr bool ENABLED = true;
+#else
+        static constexpr bool ENABLED = false;
+#endif
+
+        /** The counters. Each counted type owns six consecutive counters,
+        * in the order CountedInstance expects: constructed, copy constructed,
+        * move constructed, copy assigned, move assigned and destroyed.
+        */
+        enum Counter {
+            ITEM_CONSTRUCTED, ITEM_COPY_CONSTRUCTED, ITEM_MOVE_CONSTRUCTED,
+            ITEM_COPY_ASSIGNED, ITEM_MOVE_ASSIGNED, ITEM_DESTROYED,
+            INVENTORY_CONSTRUCTED, INVENTORY_COPY_CONSTRUCTED, INVENTORY_MOVE_CONSTRUCTED,
+            INVENTORY_COPY_ASSIGNED, INVENTORY_MOVE_ASSIGNED, INVENTORY_DESTROYED,
+            PLAYER_CONSTRUCTED, PLAYER_COPY_CONSTRUCTED, PLAYER_MOVE_CONSTRUCTED,
+            PLAYER_COPY_ASSIGNED, PLAYER_MOVE_ASSIGNED, PLAYER_DESTROYED,
+            EQUIPPED_ALLOCATED,  // `new Item`, e.g. an equipped item or its deep copy
+            EQUIPPED_FREED,      // `delete` of a heap Item
+            GRID_COPIES,         // Shared Inventory grids duplicated by their first write
+            GRID_BYTES_COPIED,   // sizeof(Item) times the cells of those grids
+            COUNTER_COUNT
+        };
+
+        /**
+         * @brief The process-wide counter totals at one point in time.
+         */
+        struct Snapshot {
+            // Indexed by Counter
+            std::array<std::uint64_t, COUNTER_COUNT> values;
+
+            /**
+             * @brief Retrieves one counter.
+             * @param counter The counter to read.
+             * @return Its total when the snapshot was taken.
+             */
+            std::uint64_t get(Counter counter) const;
+
+            /**
+             * @brief Subtracts an earlier snapshot, giving the events in between.
+             * @param earlier A snapshot taken before this one.
+             * @return A Snapshot holding the per-counter differences.
+             */
+            Snapshot since(const Snapshot& earlier) const;
+        };
+
+        /**
+         * @brief Adds to one of the calling thread's counters.
+         * @param counter The counter to bump.
+         * @param amount The amount to add. Defaults to 1.
+         * @note Compiles to nothing unless MMORPG_INSTRUMENT is defined.
+         */
+        static void record(Counter counter, std::uint64_t amount = 1) noexcept {
+#ifdef MMORPG_INSTRUMENT
+            recordLocal(counter, amount);
+#else
+            (void)counter;
+            (void)amount;
+#endif
+        }
+
+        /**
+         * @brief Sums the counters of every thread, including exited ones.
+         * @return The current totals; all zero when instrumentation is compiled out.
+         * @note Takes a lock shared with thread start-up and exit, never with `record`.
+         */
+        static Snapshot snapshot();
+
+        /**
+         * @brief Names a counter for export, e.g. "item.copy_constructed".
+         * @param counter The counter to name.
+         * @return A static, dot-separated lowercase name.
+         */
+        static const char* getName(Counter counter);
+
+    private:
+        /**
+         * @brief Adds to the calling thread's counter, or to the exited-thread
+         *  totals once the thread's counters have been destroyed.
+         */
+        static void recordLocal(Counter counter, std::uint64_t amount) noexcept;
+};
+
+/**
+ * @brief An empty base that counts the lifecycle of the class deriving from it.
+ * @tparam FIRST The class's `*_CONSTRUCTED` counter; the next five follow it.
+ * NOTE: The derived class's implicit special members count themselves through this base.
+ *       User-defined copy and move constructors must pass `rhs` on to it, and
+ *       user-defined assignment operators must record their own counter.
+ */
+template <Instrumentation::Counter FIRST>
+struct CountedInstance {
+#ifdef MMORPG_INSTRUMENT
+    CountedInstance() noexcept { bump(0); }
+    CountedInstance(const CountedInstance&) noexcept { bump(1); }
+    CountedInstance(CountedInstance&&) noexcept { bump(2); }
+    CountedInstance& operator=(const CountedInstance&) noexcept { bump(3); return *this; }
+    CountedInstance& operator=(CountedInstance&&) noexcept { bump(4); return *this; }
+    ~CountedInstance() { bump(5); }
+
+    private:
+        static void bump(int offset) noexcept {
+            Instrumentation::record(static_cast<Instrumentation::Counter>(FIRST + offset));
+        }
+#endif
+};
@@ -1,32 +1,323 @@
 #include "Inventory.hpp"
-#include <stdexcept> // For std::out_of_range
+#include <algorithm> // For std::sort
+#include <atomic>    // For std::atomic_thread_fence
+#include <iterator>  // For std::make_move_iterator
+#include <memory>    // For std::allocate_shared, std::destroy_at
+#include <stdexcept> // For std::out_of_range, std::invalid_argument
+#include <utility>   // For std::exchange, std::swap
+
+/**
+* @brief Replaces a pmr vector with another, taking over its buffer and memory resource.
+* @param target The vector to replace.
+* @param source The vector to take over, left empty.
+* NOTE: Move assignment would copy element-wise between different resources;
+*       rebuilding `target` in place never allocates.
+*/
+template <typename T>
+static void adoptStorage(std::pmr::vector<T>& target, std::pmr::vector<T>&& source) noexcept {
+    if (target.get_allocator() == source.get_allocator()) {
+        target = std::move(source);
+        return;
+    }
+    std::destroy_at(&target);
+    ::new (static_cast<void*>(&target)) std::pmr::vector<T>(std::move(source));
+}
 
 /**
 * @brief Constructor with optional parameters for initialization.
 * @param items A const reference to a 2D vector of items.
 *  Defaults to a 10x10 grid of default-constructed items, if none provided.
-* @param equipped A pointer to an Item object.
-*  Defaults to nullptr, if none provided.
+* @param equipped A pointer to an Item object allocated with `new`.
+*  The Inventory takes ownership of it. Defaults to nullptr, if none provided.
 *
 * @post Initializes members in the following way:
 * 1) Initializes `weight_` as the total weight of all items in `items` (excluding NONE type)
 * 2) Initialies `item_count_` as the count of non-NONE items.
 *
 * NOTE: The `equipped` item is excluded from these calculations.
+* @param alloc The allocator whose memory resource backs the grid. Defaults to the default resource.
+* @throws std::invalid_argument If the rows of `items` differ in length.
 */
 Inventory::Inventory(
         const std::vector<std::vector<Item>>& items,
-        Item* equipped
-) : inventory_grid_(items), equipped_(equipped), weight_(0), item_count_(0) {
-    // Compute initial weight and item count (excluding equipped item)
-    for (const auto& row : inventory_grid_) {
-        for (const auto& item : row) {
-            if (item.type_ != NONE) {
-                weight_ += item.weight_;
-                item_count_++;
-            }
+        Item* equipped,
+        const allocator_type& alloc
+) : resource_(alloc.resource()), inventory_grid_(), rows_(items.size()), cols_(items.empty() ? 0 : items[0].size()),
+    equipped_(equipped), weight_(0), item_count_(0), type_counts_(), type_weights_(), max_weight_(0), occupied_cells_(alloc),
+    dirty_cells_(alloc), dirty_words_(alloc), equipped_dirty_(false) {
+    for (const auto& row : items) {
+        if (row.size() != cols_) {
+            throw std::invalid_argument("Inventory rows must all have the same length.");
+        }
+    }
+
+    // Flatten rows into the contiguous grid
+    std::vector<Item> cells;
+    cells.reserve(rows_ * cols_);
+    for (const auto& row : items) {
+        cells.insert(cells.end(), row.begin(), row.end());
+    }
+    adoptCells(std::move(cells));
+}
+
+/**
+* @brief Constructor that moves the items out of a pre-built grid.
+* @param items An r-value reference to a 2D vector of items, left with moved-from Items.
+* @param equipped A pointer to an Item object allocated with `new`.
+*  The Inventory takes ownership of it. Defaults to nullptr, if none provided.
+*
+* @param alloc The allocator whose memory resource backs the grid. Defaults to the default resource.
+*
+* @post Initializes `weight_` and `item_count_` as the 2D vector constructor does.
+* @throws std::invalid_argument If the rows of `items` differ in length.
+*/
+Inventory::Inventory(
+        std::vector<std::vector<Item>>&& items,
+        Item* equipped,
+        const allocator_type& alloc
+) : resource_(alloc.resource()), inventory_grid_(), rows_(items.size()), cols_(items.empty() ? 0 : items[0].size()),
+    equipped_(equipped), weight_(0), item_count_(0), type_counts_(), type_weights_(), max_weight_(0), occupied_cells_(alloc),
+    dirty_cells_(alloc), dirty_words_(alloc), equipped_dirty_(false) {
+    for (const auto& row : items) {
+        if (row.size() != cols_) {
+            throw std::invalid_argument("Inventory rows must all have the same length.");
+        }
+    }
+
+    // Flatten rows into the contiguous grid, moving each Item
+    std::vector<Item> cells;
+    cells.reserve(rows_ * cols_);
+    for (auto& row : items) {
+        cells.insert(cells.end(), std::make_move_iterator(row.begin()), std::make_move_iterator(row.end()));
+    }
+    adoptCells(std::move(cells));
+}
+
+/**
+* @brief Constructor that takes over a flat, row-major grid.
+* @param rows The number of rows in the grid.
+* @param cols The number of columns in each row of the grid.
+* @param cells The rows * cols cells in row-major order. Pass an r-value to avoid copying.
+* @param equipped A pointer to an Item object allocated with `new`.
+*  The Inventory takes ownership of it. Defaults to nullptr, if none provided.
+*
+* @param alloc The allocator whose memory resource backs the grid. Defaults to the default resource.
+*
+* @post Initializes `weight_` and `item_count_` as the 2D vector constructor does.
+* @throws std::invalid_argument If `cells` does not hold exactly rows * cols items.
+*/
+Inventory::Inventory(size_t rows, size_t cols, std::vector<Item> cells, Item* equipped, const allocator_type& alloc)
+        : resource_(alloc.resource()), inventory_grid_(), rows_(rows), cols_(cols),
+          equipped_(equipped), weight_(0), item_count_(0), type_counts_(), type_weights_(), max_weight_(0), occupied_cells_(alloc),
+          dirty_cells_(alloc), dirty_words_(alloc), equipped_dirty_(false) {
+    if (cells.size() != rows_ * cols_) {
+        throw std::invalid_argument("Inventory cells must fill rows * cols exactly.");
+    }
+    adoptCells(std::move(cells));
+}
+
+/**
+* @brief Installs a flat grid and derives the bookkeeping members from it.
+* @param cells The rows_ * cols_ cells of the grid in row-major order.
+* @post Initializes `weight_`, `item_count_` and the per-type tables from the non-NONE cells
+*  and marks those cells in `occupied_cells_`. No cell is marked dirty.
+*/
+void Inventory::adoptCells(std::vector<Item>&& cells) {
+    inventory_grid_ = std::allocate_shared<std::pmr::vector<Item>>(
+        allocator_type(resource_), std::make_move_iterator(cells.begin()), std::make_move_iterator(cells.end()));
+
+    // Compute initial weight, item count and occupancy (excluding equipped item)
+    occupied_cells_.assign((rows_ * cols_ + 63) / 64, 0);
+    dirty_cells_.assign(occupied_cells_.size(), 0);
+    dirty_words_.clear();
+    for (size_t index = 0; index < inventory_grid_->size(); index++) {
+        const Item& item = (*inventory_grid_)[index];
+        if (item.type_ != NONE) {
+            weight_ += item.weight_;
+            item_count_++;
+            tallyType(item);
+            markOccupied(index, true);
+        }
+    }
+}
+
+/**
+* @brief Adds an item that entered the grid to `type_counts_`, `type_weights_` and `max_weight_`.
+* @param item A const ref. to the stored item. NONE items are not counted.
+*/
+void Inventory::tallyType(const Item& item) {
+    if (item.type_ == NONE) { return; }
+    type_counts_[item.type_]++;
+    type_weights_[item.type_] += item.weight_;
+    max_weight_ = std::max(max_weight_, item.weight_);
+}
+
+/**
+* @brief Removes an item that left the grid from `type_counts_`, `type_weights_` and `max_weight_`.
+* @param item A const ref. to the removed item, which must no longer be in the grid.
+* @note O(1), except that removing the heaviest item rescans the occupied cells
+*  for the new maximum, which is O(cells).
+*/
+void Inventory::untallyType(const Item& item) {
+    if (item.type_ == NONE) { return; }
+    // Reset emptied totals exactly, so repeated add/remove cycles do not accumulate rounding drift
+    type_weights_[item.type_] = (--type_counts_[item.type_] == 0) ? 0 : type_weights_[item.type_] - item.weight_;
+    if (item.weight_ < max_weight_) { return; }
+
+    max_weight_ = 0;
+    for (size_t word = 0; word < occupied_cells_.size(); word++) {
+        for (std::uint64_t bits = occupied_cells_[word]; bits; bits &= bits - 1) {
+            size_t index = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+            max_weight_ = std::max(max_weight_, (*inventory_grid_)[index].weight_);
+        }
+    }
+}
+
+/**
+* @brief Maps a row and column to its offset in `inventory_grid_`.
+* @param row A size_t parameter for the row index in the inventory grid.
+* @param col A size_t parameter for the column index in the inventory grid.
+* @return The offset of the cell in `inventory_grid_`.
+* @throws std::out_of_range If the row or column is out of bounds.
+*/
+size_t Inventory::cellIndex(const size_t& row, const size_t& col) const {
+    if (row >= rows_ || col >= cols_) {
+        throw std::out_of_range("Invalid inventory index."); // Out of bounds
+    }
+    return row * cols_ + col;
+}
+
+/**
+* @brief Gives this Inventory its own copy of `inventory_grid_` if it is shared.
+* @post `inventory_grid_` is referenced by this Inventory only and may be mutated.
+* NOTE: Every member that writes to the grid must call this first.
+*/
+void Inventory::detachGrid() {
+    if (!inventory_grid_) {
+        inventory_grid_ = std::allocate_shared<std::pmr::vector<Item>>(allocator_type(resource_));
+    } else if (inventory_grid_.use_count() > 1) {
+        Instrumentation::record(Instrumentation::GRID_COPIES);
+        Instrumentation::record(Instrumentation::GRID_BYTES_COPIED, inventory_grid_->size() * sizeof(Item));
+        inventory_grid_ = std::allocate_shared<std::pmr::vector<Item>>(allocator_type(resource_), *inventory_grid_);
+    } else {
+        // Pairs with the release in the last other owner's reference drop, so its
+        // reads of the grid happen before our writes
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+}
+
+/**
+* @brief Moves the grid and the bitsets to another memory resource.
+* @param resource The resource to allocate from from now on.
+* @post A grid shared with other Inventories is copied; an unshared one has its Items moved.
+*  If an allocation throws, this Inventory is left unchanged.
+*/
+void Inventory::rehome(std::pmr::memory_resource* resource) {
+    std::pmr::vector<std::uint64_t> occupied(occupied_cells_, resource);
+    std::pmr::vector<std::uint64_t> dirty(dirty_cells_, resource);
+    std::pmr::vector<size_t> dirtyWords(dirty_words_, resource);
+
+    // The grid is re-allocated last, so a failure never leaves its Items moved out
+    if (inventory_grid_) {
+        std::pmr::vector<Item>& grid = *inventory_grid_;
+        Instrumentation::record(Instrumentation::GRID_COPIES);
+        Instrumentation::record(Instrumentation::GRID_BYTES_COPIED, grid.size() * sizeof(Item));
+        inventory_grid_ = (inventory_grid_.use_count() == 1)
+            ? std::allocate_shared<std::pmr::vector<Item>>(
+                  allocator_type(resource), std::make_move_iterator(grid.begin()), std::make_move_iterator(grid.end()))
+            : std::allocate_shared<std::pmr::vector<Item>>(allocator_type(resource), grid);
+    }
+    resource_ = resource;
+    adoptStorage(occupied_cells_, std::move(occupied));
+    adoptStorage(dirty_cells_, std::move(dirty));
+    adoptStorage(dirty_words_, std::move(dirtyWords));
+}
+
+/**
+* @brief Takes over the grid, bitsets and totals of an Inventory on an equal memory resource.
+* @param source An l-value ref. to the Inventory to empty.
+* @post `source` is left in the valid empty state of a moved-from Inventory.
+*  Assigning `equipped_` destroys the overridden item.
+*/
+void Inventory::takeStorage(Inventory& source) noexcept {
+    inventory_grid_ = std::move(source.inventory_grid_);
+    rows_ = source.rows_;
+    cols_ = source.cols_;
+    equipped_ = std::move(source.equipped_);
+    weight_ = source.weight_;
+    item_count_ = source.item_count_;
+    type_counts_ = source.type_counts_;
+    type_weights_ = source.type_weights_;
+    max_weight_ = source.max_weight_;
+    adoptStorage(occupied_cells_, std::move(source.occupied_cells_));
+    adoptStorage(dirty_cells_, std::move(source.dirty_cells_));
+    adoptStorage(dirty_words_, std::move(source.dirty_words_));
+    equipped_dirty_ = source.equipped_dirty_;
+
+    // Leave source in valid empty state
+    source.occupied_cells_.clear();
+    source.dirty_cells_.clear();
+    source.dirty_words_.clear();
+    source.equipped_dirty_ = false;
+    source.rows_ = 0;
+    source.cols_ = 0;
+    source.weight_ = 0;
+    source.item_count_ = 0;
+    source.type_counts_.fill(0);
+    source.type_weights_.fill(0);
+    source.max_weight_ = 0;
+}
+
+/**
+* @brief Sets or clears one cell's bit in `occupied_cells_`.
+* @param index The offset of the cell in `inventory_grid_`.
+* @param occupied True if the cell now holds a non-NONE item.
+*/
+void Inventory::markOccupied(size_t index, bool occupied) {
+    std::uint64_t bit = std::uint64_t{1} << (index % 64);
+    if (occupied) {
+        occupied_cells_[index / 64] |= bit;
+    } else {
+        occupied_cells_[index / 64] &= ~bit;
+    }
+}
+
+/**
+* @brief Records that a cell was written since the last checkpoint.
+* @param index The offset of the cell in `inventory_grid_`.
+* NOTE: Every member that writes a cell must call this.
+*/
+void Inventory::markDirty(size_t index) {
+    std::uint64_t& word = dirty_cells_[index / 64];
+    if (!word) { dirty_words_.push_back(index / 64); }
+    word |= std::uint64_t{1} << (index % 64);
+}
+
+/**
+* @brief Finds the first free cell at or after an offset.
+* @param start The offset in `inventory_grid_` to start searching from.
+* @return The offset of the first NONE cell at or after `start`,
+*  or `rows_ * cols_` if there is none.
+*/
+size_t Inventory::nextFreeIndex(size_t start) const {
+    size_t cellCount = rows_ * cols_;
+    for (size_t word = start / 64; word < occupied_cells_.size(); word++) {
+        std::uint64_t free = ~occupied_cells_[word];
+        if (word == start / 64) { free &= ~std::uint64_t{0} << (start % 64); } // Skip cells before `start`
+        if (free) {
+            size_t index = word * 64 + static_cast<size_t>(__builtin_ctzll(free));
+            return index < cellCount ? index : cellCount; // Bits past the last cell are never occupied
         }
     }
+    return cellCount;
+}
+
+/**
+* @brief Retrieves the allocator for `resource_`
+* @return The allocator that the grid and bitsets are allocated with
+*/
+Inventory::allocator_type Inventory::get_allocator() const {
+    return allocator_type(resource_);
 }
 
 /**
@@ -34,17 +325,20 @@ Inventory::Inventory(
 * @return The Item pointer stored in `equipped_`
 */
 Item* Inventory::getEquipped() const {
-    return equipped_;
+    return equipped_.get();
 }
 
 /**
 * @brief Equips a new item.
-* @param itemToEquip A pointer to the item to equip.
-* @post Updates `equipped` to the specified item
-* without deallocating the original.
+* @param itemToEquip A pointer to the item to equip, allocated with `new`.
+* @post Updates `equipped` to the specified item and takes ownership of it,
+* without deallocating the original. Ownership of the original passes
+* back to the caller.
 */
 void Inventory::equip(Item* itemToEquip) {
-    equipped_ = itemToEquip;
+    if (equipped_ || itemToEquip) { equipped_dirty_ = true; }
+    equipped_.release(); // The caller now owns the previously equipped item
+    equipped_.reset(itemToEquip);
 }
 
 /**
@@ -53,18 +347,56 @@ void Inventory::equip(Item* itemToEquip) {
 * and sets `equipped` to nullptr, if `equipped` is not nullptr already.
 */
 void Inventory::discardEquipped() {
-    if (equipped_) {
-        delete equipped_;
-        equipped_ = nullptr;
-    }
+    if (equipped_) { equipped_dirty_ = true; }
+    equipped_.reset(); // Returns the item's storage to the ItemPool
 }
 
 /**
-* @brief Retrieves the value stored in `inventory_grid_`
-* @return The vector<vector<Item>> value stored in `inventory_grid_`
+* @brief Retrieves the items stored in `inventory_grid_`
+* @return A vector<vector<Item>> with one inner vector per row of `inventory_grid_`
 */
 std::vector<std::vector<Item>> Inventory::getItems() const {
-    return inventory_grid_;
+    std::vector<std::vector<Item>> items;
+    items.reserve(rows_);
+    for (size_t row = 0; row < rows_; row++) {
+        auto rowBegin = inventory_grid_->begin() + row * cols_;
+        items.emplace_back(rowBegin, rowBegin + cols_);
+    }
+    return items;
+}
+
+/**
+* @brief Exposes `inventory_grid_` without copying it.
+* @return A read-only GridView over the grid, with row and cell access.
+* @note The view is invalidated by any later mutation of this Inventory.
+*/
+GridView Inventory::view() const {
+    return GridView(inventory_grid_ ? inventory_grid_->data() : nullptr, rows_, cols_);
+}
+
+/**
+* @brief Exposes the occupied cells of `inventory_grid_` without copying them.
+* @return A range over the non-NONE cells with their row and column, in row-major order.
+* @note The range is invalidated by any later mutation of this Inventory.
+*/
+OccupiedCells Inventory::occupied() const {
+    return view().occupied();
+}
+
+/**
+* @brief Retrieves the value stored in `rows_`
+* @return The number of rows in the inventory grid
+*/
+size_t Inventory::getRows() const {
+    return rows_;
+}
+
+/**
+* @brief Retrieves the value stored in `cols_`
+* @return The number of columns in each row of the inventory grid
+*/
+size_t Inventory::getCols() const {
+    return cols_;
 }
 
 /**
@@ -83,6 +415,32 @@ size_t Inventory::getCount() const {
     return item_count_;
 }
 
+/**
+* @brief Retrieves the number of items of one type, kept up to date on every store
+* @param type The ItemType to count.
+* @return The value stored in `type_counts_[type]`; 0 for NONE
+*/
+size_t Inventory::getCount(ItemType type) const {
+    return type_counts_[type];
+}
+
+/**
+* @brief Retrieves the total weight of the items of one type, kept up to date on every store
+* @param type The ItemType to weigh.
+* @return The value stored in `type_weights_[type]`; 0 for NONE
+*/
+float Inventory::getWeight(ItemType type) const {
+    return type_weights_[type];
+}
+
+/**
+* @brief Retrieves the weight of the heaviest item in the grid, excluding the equipped item
+* @return The value stored in `max_weight_`; 0 for an empty grid
+*/
+float Inventory::getMaxItemWeight() const {
+    return max_weight_;
+}
+
 /**
 * @brief Retrieves the item located at the specified row and column
 * in the inventory grid.
@@ -93,10 +451,8 @@ size_t Inventory::getCount() const {
 * @throws std::out_of_range If the row or column is out of bounds.
 */
 Item Inventory::at(const size_t& row, const size_t& col) const {
-    if (row >= inventory_grid_.size() || col >= inventory_grid_[row].size()) {
-        throw std::out_of_range("Invalid inventory index."); // Out of bounds
-    }
-    return inventory_grid_[row][col]; // Return the item at the specified location
+    size_t index = cellIndex(row, col); // Throws before a moved-from grid is touched
+    return (*inventory_grid_)[index];   // Return the item at the specified location
 }
 
 /**
@@ -111,28 +467,278 @@ Item Inventory::at(const size_t& row, const size_t& col) const {
 * @throws std::out_of_range If the row or column is out of bounds.
 */
 bool Inventory::store(const size_t& row, const size_t& col, const Item& pickup) {
-    if (row >= inventory_grid_.size() || col >= inventory_grid_[row].size()) {
-        throw std::out_of_range("Invalid inventory index."); // Out of bounds
+    size_t index = cellIndex(row, col);
+    if ((*inventory_grid_)[index].type_ != NONE) {
+        return false; // Cell is occupied
+    }
+    placeAt(index, Item(pickup));
+    return true;
+}
+
+/**
+* @brief Stores an item at the specified row and column, moving it into the cell.
+*
+* @param row A size_t parameter for the row index in the inventory grid.
+* @param col  A size_t parameter for the column index in the inventory grid.
+* @param pickup An r-value ref. to the item to store. It is only moved from if stored.
+* @return True if the item was successfully stored, false if the cell is already occupied.
+*
+* @post Updates `item_count_` and `weight_` if the Item is sucessfully added
+* @throws std::out_of_range If the row or column is out of bounds.
+*/
+bool Inventory::store(const size_t& row, const size_t& col, Item&& pickup) {
+    size_t index = cellIndex(row, col);
+    if ((*inventory_grid_)[index].type_ != NONE) {
+        return false; // Cell is occupied
     }
-    if (inventory_grid_[row][col].type_ != NONE) {
+    placeAt(index, std::move(pickup));
+    return true;
+}
+
+/**
+* @brief Constructs an item directly in the specified cell of the inventory grid.
+*
+* @param row A size_t parameter for the row index in the inventory grid.
+* @param col  A size_t parameter for the column index in the inventory grid.
+* @param name The name of the new item. Pass an r-value to avoid copying it.
+* @param weight A float representing the weight of the new item.
+* @param type An ItemType specifying the type of the new item.
+* @return True if the item was successfully stored, false if the cell is already occupied.
+*
+* @post Updates `item_count_` and `weight_` if the Item is sucessfully added
+* @throws std::out_of_range If the row or column is out of bounds.
+*/
+bool Inventory::emplace(const size_t& row, const size_t& col, std::string name, float weight, ItemType type) {
+    size_t index = cellIndex(row, col);
+    if ((*inventory_grid_)[index].type_ != NONE) {
         return false; // Cell is occupied
     }
-    inventory_grid_[row][col] = pickup;
-    weight_ += pickup.weight_;
+    placeAt(index, Item(std::move(name), weight, type));
+    return true;
+}
+
+/**
+* @brief Moves an item into an empty cell and updates the bookkeeping members.
+* @param index The offset of an empty cell in `inventory_grid_`.
+* @param pickup An r-value ref. to the item to place.
+* @post Updates `item_count_`, `weight_`, the per-type tables, `occupied_cells_` and marks the cell dirty.
+*  A NONE pickup changes nothing, since the cell stays empty.
+*/
+void Inventory::placeAt(size_t index, Item&& pickup) {
+    if (pickup.type_ == NONE) { return; } // Counting it would break getCount() == occupied cells
+    detachGrid();
+    Item& cell = (*inventory_grid_)[index];
+    cell = std::move(pickup);
+    markOccupied(index, cell.type_ != NONE);
+    markDirty(index);
+    weight_ += cell.weight_;
     item_count_++;
+    tallyType(cell);
+}
+
+/**
+* @brief Finds the first empty cell in row-major order.
+* @return The (row, col) of the first NONE cell, or std::nullopt if the grid is full.
+*/
+std::optional<std::pair<size_t, size_t>> Inventory::findFreeSlot() const {
+    size_t index = nextFreeIndex(0);
+    if (index == rows_ * cols_) { return std::nullopt; }
+    return std::make_pair(index / cols_, index % cols_);
+}
+
+/**
+* @brief Stores an item in the first empty cell.
+* @param pickup A const ref. to the item to store.
+* @return The (row, col) where the item was stored, or std::nullopt if the grid is full.
+* 
+* @post Updates `item_count_` and `weight_` if the Item is sucessfully added
+*/
+std::optional<std::pair<size_t, size_t>> Inventory::autoStore(const Item& pickup) {
+    auto slot = findFreeSlot();
+    if (slot) { store(slot->first, slot->second, pickup); }
+    return slot;
+}
+
+/**
+* @brief Stores a batch of items in first-fit order.
+* @param pickups A const ref. to the items to store, placed in order.
+* @return One entry per element of `pickups`: the (row, col) where it was stored,
+*  or std::nullopt if the grid was already full or the pickup is a NONE item,
+*  which is not stored and leaves its cell free for the next pickup.
+* 
+* @post Updates `item_count_` and `weight_` once for the whole batch,
+*  and the per-type tables per placed item.
+*/
+std::vector<std::optional<std::pair<size_t, size_t>>> Inventory::storeMany(const std::vector<Item>& pickups) {
+    std::vector<std::optional<std::pair<size_t, size_t>>> placements(pickups.size());
+    size_t cellCount = rows_ * cols_;
+    if (pickups.empty() || nextFreeIndex(0) == cellCount) { return placements; }
+    detachGrid();
+
+    float addedWeight = 0;
+    size_t addedCount = 0;
+    size_t index = 0;
+    for (size_t i = 0; i < pickups.size(); i++) {
+        if (pickups[i].type_ == NONE) { continue; } // Nothing to store
+        index = nextFreeIndex(index);
+        if (index == cellCount) { break; } // Full: the remaining pickups stay unplaced
+        placements[i] = std::make_pair(index / cols_, index % cols_);
+        (*inventory_grid_)[index] = pickups[i];
+        markOccupied(index, true);
+        markDirty(index);
+        tallyType(pickups[i]);
+        addedWeight += pickups[i].weight_;
+        addedCount++;
+        index++;
+    }
+    weight_ += addedWeight;
+    item_count_ += addedCount;
+    return placements;
+}
+
+/**
+* @brief Removes the item from the specified cell.
+*
+* @param row A size_t parameter for the row index in the inventory grid.
+* @param col A size_t parameter for the column index in the inventory grid.
+* @return The removed item, moved out of the cell, or a NONE Item if the cell was empty.
+*
+* @post Updates `item_count_`, `weight_` and the per-type tables and marks the cell dirty
+*  if an item was removed.
+* @throws std::out_of_range If the row or column is out of bounds.
+* @note O(1), unless the removed item was the heaviest in the grid: `max_weight_`
+*  is then recomputed by rescanning every occupied cell, O(cells).
+*/
+Item Inventory::take(const size_t& row, const size_t& col) {
+    size_t index = cellIndex(row, col);
+    if ((*inventory_grid_)[index].type_ == NONE) { return Item(); } // Nothing to take
+    detachGrid();
+    Item taken = std::exchange((*inventory_grid_)[index], Item());
+    markOccupied(index, false);
+    markDirty(index);
+    item_count_--;
+    weight_ = (item_count_ == 0) ? 0 : weight_ - taken.weight_;
+    untallyType(taken);
+    return taken;
+}
+
+/**
+* @brief Moves an item into an empty cell of the same grid.
+*
+* @param fromRow The row index of the cell holding the item.
+* @param fromCol The column index of the cell holding the item.
+* @param toRow The row index of the empty destination cell.
+* @param toCol The column index of the empty destination cell.
+* @return True if the item was moved, false if the source is empty or the destination is occupied.
+*
+* @post The item is relocated without copying it; `weight_`, `item_count_` and
+*  the per-type tables are unchanged. Both cells are marked dirty.
+* @throws std::out_of_range If either cell is out of bounds.
+*/
+bool Inventory::moveCell(const size_t& fromRow, const size_t& fromCol, const size_t& toRow, const size_t& toCol) {
+    size_t from = cellIndex(fromRow, fromCol);
+    size_t to = cellIndex(toRow, toCol);
+    if ((*inventory_grid_)[from].type_ == NONE || (*inventory_grid_)[to].type_ != NONE) { return false; }
+    detachGrid();
+    (*inventory_grid_)[to] = std::exchange((*inventory_grid_)[from], Item());
+    markOccupied(from, false);
+    markOccupied(to, true);
+    markDirty(from);
+    markDirty(to);
     return true;
 }
 
+/**
+* @brief Exchanges the contents of two cells, either of which may be empty.
+*
+* @param firstRow The row index of the first cell.
+* @param firstCol The column index of the first cell.
+* @param secondRow The row index of the second cell.
+* @param secondCol The column index of the second cell.
+*
+* @post The items are relocated without copying them; `weight_`, `item_count_` and
+*  the per-type tables are unchanged. Both cells are marked dirty unless they are the same cell.
+* @throws std::out_of_range If either cell is out of bounds.
+*/
+void Inventory::swapCells(const size_t& firstRow, const size_t& firstCol, const size_t& secondRow, const size_t& secondCol) {
+    size_t first = cellIndex(firstRow, firstCol);
+    size_t second = cellIndex(secondRow, secondCol);
+    if (first == second) { return; }
+    detachGrid();
+    std::pmr::vector<Item>& grid = *inventory_grid_;
+    std::swap(grid[first], grid[second]);
+    markOccupied(first, grid[first].type_ != NONE);
+    markOccupied(second, grid[second].type_ != NONE);
+    markDirty(first);
+    markDirty(second);
+}
+
+/**
+* @brief Checks whether anything changed since the last checkpoint.
+* @return True if a cell was written or the equipped item changed since the
+*  last drainChanges() (or since construction).
+*/
+bool Inventory::hasChanges() const {
+    return equipped_dirty_ || !dirty_words_.empty();
+}
+
+/**
+* @brief Collects the changes since the last checkpoint and starts a new one.
+* @return The written cells in row-major order and whether the equipped item changed.
+*  Read the current contents through view() or at().
+*  A copy's checkpoint is the moment it was copied, including copy assignment.
+* 
+* @post No cell is dirty and `equipped_dirty_` is false.
+* @note O(changes): only the bitset words that were dirtied are visited.
+*/
+InventoryChanges Inventory::drainChanges() {
+    InventoryChanges changes{{}, equipped_dirty_};
+    std::sort(dirty_words_.begin(), dirty_words_.end());
+    for (size_t word : dirty_words_) {
+        for (std::uint64_t bits = dirty_cells_[word]; bits; bits &= bits - 1) {
+            size_t index = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+            changes.cells.emplace_back(index / cols_, index % cols_);
+        }
+        dirty_cells_[word] = 0;
+    }
+    dirty_words_.clear();
+    equipped_dirty_ = false;
+    return changes;
+}
+
 /**
 * @brief Copy constructor for the Inventory class.
 * @param rhs A const l-value ref. to the Inventory object to copy.
 * @post Creates a deep copy of `rhs`,
 *  including duplicating the dynamically
 *  allocated item in `equipped`.
+*  The grid is shared with `rhs` until either side mutates it,
+*  provided `rhs` uses the default memory resource; otherwise it is copied into it.
+*  The copy starts a checkpoint of its own: none of the changes pending in `rhs`
+*  are reported by its first drainChanges(). Moves carry the pending changes along.
+*/
+Inventory::Inventory(const Inventory& rhs) : Inventory(rhs, allocator_type()) {}
+
+/**
+* @brief Allocator-extended copy constructor for the Inventory class.
+* @param rhs A const l-value ref. to the Inventory object to copy.
+* @param alloc The allocator whose memory resource backs the copy.
+* @post As the copy constructor, except that the grid is shared only
+*  if `rhs` uses the same memory resource as `alloc`.
 */
-Inventory::Inventory(const Inventory& rhs)
-        : inventory_grid_(rhs.inventory_grid_), weight_(rhs.weight_), item_count_(rhs.item_count_) {
-    equipped_ = (rhs.equipped_) ? new Item(*rhs.equipped_) : nullptr;
+Inventory::Inventory(const Inventory& rhs, const allocator_type& alloc)
+        : CountedInstance(rhs), resource_(alloc.resource()), inventory_grid_(), rows_(rhs.rows_), cols_(rhs.cols_),
+          equipped_((rhs.equipped_) ? new Item(*rhs.equipped_) : nullptr),
+          weight_(rhs.weight_), item_count_(rhs.item_count_), type_counts_(rhs.type_counts_),
+          type_weights_(rhs.type_weights_), max_weight_(rhs.max_weight_), occupied_cells_(rhs.occupied_cells_, alloc),
+          dirty_cells_(rhs.dirty_cells_.size(), 0, alloc), dirty_words_(alloc), equipped_dirty_(false) {
+    if (!rhs.inventory_grid_ || rhs.resource_ == resource_) {
+        inventory_grid_ = rhs.inventory_grid_;
+        return;
+    }
+    Instrumentation::record(Instrumentation::GRID_COPIES);
+    Instrumentation::record(Instrumentation::GRID_BYTES_COPIED, rhs.inventory_grid_->size() * sizeof(Item));
+    inventory_grid_ = std::allocate_shared<std::pmr::vector<Item>>(alloc, *rhs.inventory_grid_);
 }
 
 /**
@@ -146,14 +752,51 @@ Inventory::Inventory(const Inventory& rhs)
 * - All numerical values are set to 0
 * - All containers are cleared to have size 0
 */
-Inventory::Inventory(Inventory&& rhs)
-        : inventory_grid_(std::move(rhs.inventory_grid_)),
-          equipped_(rhs.equipped_),
+Inventory::Inventory(Inventory&& rhs) noexcept
+        : CountedInstance(std::move(rhs)),
+          resource_(rhs.resource_),
+          inventory_grid_(std::move(rhs.inventory_grid_)),
+          rows_(rhs.rows_),
+          cols_(rhs.cols_),
+          equipped_(std::move(rhs.equipped_)),
           weight_(rhs.weight_),
-          item_count_(rhs.item_count_) {
-    rhs.equipped_ = nullptr;
+          item_count_(rhs.item_count_),
+          type_counts_(rhs.type_counts_),
+          type_weights_(rhs.type_weights_),
+          max_weight_(rhs.max_weight_),
+          occupied_cells_(std::move(rhs.occupied_cells_)),
+          dirty_cells_(std::move(rhs.dirty_cells_)),
+          dirty_words_(std::move(rhs.dirty_words_)),
+          equipped_dirty_(rhs.equipped_dirty_) {
+    rhs.occupied_cells_.clear();
+    rhs.dirty_cells_.clear();
+    rhs.dirty_words_.clear();
+    rhs.equipped_dirty_ = false;
+    rhs.rows_ = 0;
+    rhs.cols_ = 0;
     rhs.weight_ = 0;
     rhs.item_count_ = 0;
+    rhs.type_counts_.fill(0);
+    rhs.type_weights_.fill(0);
+    rhs.max_weight_ = 0;
+}
+
+/**
+* @brief Allocator-extended move constructor for the Inventory class.
+* @param rhs An r-value ref. to the Inventory object to move from.
+* @param alloc The allocator whose memory resource backs the new Inventory.
+* @post As the move constructor when `rhs` uses the same memory resource as `alloc`,
+*  so moves within one arena stay pointer swaps. Otherwise the grid and bitsets
+*  are then re-allocated from `alloc`; if that throws, `rhs` is left unchanged.
+*/
+Inventory::Inventory(Inventory&& rhs, const allocator_type& alloc) : Inventory(std::move(rhs)) {
+    if (*resource_ == *alloc.resource()) { return; }
+    try {
+        rehome(alloc.resource());
+    } catch (...) {
+        rhs.takeStorage(*this); // A failed rehome changes nothing, so rhs can take its storage back
+        throw;
+    }
 }
 
 /**
@@ -162,20 +805,21 @@ Inventory::Inventory(Inventory&& rhs)
 * @return A reference to the updated Inventory object.
 * @post Performs a deep copy of `rhs`, including
 * re-allocating and copying the item in `equipped`.
+* The grid is shared with `rhs` until either side mutates it.
+* If the copy throws, this object is left unchanged.
 *
 * NOTE: The resources of the overridden object
 * should be destroyed.
 */
 Inventory& Inventory::operator=(const Inventory& rhs) {
+    Instrumentation::record(Instrumentation::INVENTORY_COPY_ASSIGNED);
     if (this != &rhs) {
-        // Cleanup existing resources
-        delete equipped_;
+        // Copy resources first, so a failed allocation leaves *this untouched.
+        // The copy uses this object's memory resource, which the move below keeps.
+        Inventory copy(rhs, get_allocator());
 
-        // Copy resources
-        inventory_grid_ = rhs.inventory_grid_;
-        weight_ = rhs.weight_;
-        item_count_ = rhs.item_count_;
-        equipped_ = (rhs.equipped_) ? new Item(*rhs.equipped_) : nullptr;
+        // Cleanup existing resources and take over the copy's
+        *this = std::move(copy);
     }
     return *this;
 }
@@ -193,23 +837,20 @@ Inventory& Inventory::operator=(const Inventory& rhs) {
 * - All containers are cleared to have size 0
 *
 * NOTE: The resources of the overridden object
-* should be destroyed.
+* should be destroyed. This object keeps its own memory resource: the storage
+* of `rhs` is taken over only if both resources compare equal. Otherwise, as
+* std::pmr containers do for unequal allocators, the contents are copied onto
+* this object's resource, and if that throws both objects are left unchanged.
 */
 Inventory& Inventory::operator=(Inventory&& rhs) {
-    if (this != &rhs) {
-        // Cleanup existing resources
-        delete equipped_;
-
-        // Move resources
-        inventory_grid_ = std::move(rhs.inventory_grid_);
-        equipped_ = rhs.equipped_;
-        weight_ = rhs.weight_;
-        item_count_ = rhs.item_count_;
-
-        // Leave rhs in valid empty state
-        rhs.equipped_ = nullptr;
-        rhs.weight_ = 0;
-        rhs.item_count_ = 0;
+    Instrumentation::record(Instrumentation::INVENTORY_MOVE_ASSIGNED);
+    if (this == &rhs) { return *this; }
+    if (*resource_ != *rhs.resource_) {
+        Inventory copy(rhs, get_allocator()); // May throw before anything is modified
+        Inventory emptied(std::move(rhs));    // Leaves rhs empty, as a move would
+        takeStorage(copy);
+    } else {
+        takeStorage(rhs);
     }
     return *this;
 }
@@ -219,6 +860,5 @@ Inventory& Inventory::operator=(Inventory&& rhs) {
 * @post Deallocates any dynamically allocated resources.
 */
 Inventory::~Inventory() {
-    delete equipped_;
-    equipped_ = nullptr;
+    equipped_.reset(); // Returns the item's storage to the ItemPool
 }
@@ -1,44 +1,233 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "GridView.hpp"
 #include "Item.hpp"
 
-class Inventory {
+/**
+ * @brief The changes an Inventory collected since its last checkpoint.
+ */
+struct InventoryChanges {
+    std::vector<std::pair<size_t, size_t>> cells; // The (row, col) of every written cell, in row-major order
+    bool equipped;                                // True if the equipped item was replaced or discarded
+};
+
+class Inventory : CountedInstance<Instrumentation::INVENTORY_CONSTRUCTED> {
+    public:
+        // Lets std::pmr containers of Players pass their memory resource down to each Inventory
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
     private: 
+        /** The memory resource that the grid, its control block and the bitsets are allocated from.
+        * Copies allocate from the resource they are given (the default resource unless
+        * allocator-extended), and move construction carries it along. Assignment never
+        * changes it: like a std::pmr container, an Inventory keeps its resource for life.
+        * Item names longer than the small-string buffer still use the global heap.
+        */
+        std::pmr::memory_resource* resource_;
+
         /** A dynamic grid for storing non-equipped items.
-        * Each outer vector represents a row in the grid,
-        * while the inner vectors represent columns within those rows.
+        * The grid is kept in a single contiguous buffer in row-major order,
+        * so the cell at (row, col) lives at index `row * cols_ + col`.
+        *
+        * Copies of an Inventory share the same buffer (copy-on-write):
+        * it is only duplicated by the first mutation of a shared grid.
+        * A moved-from Inventory holds nullptr, which is treated as an empty grid.
+        * Only Inventories on the same memory resource share a grid.
         */
-        std::vector<std::vector<Item>> inventory_grid_;
+        std::shared_ptr<std::pmr::vector<Item>> inventory_grid_;
+
+        // The number of rows in `inventory_grid_`
+        size_t rows_;
+
+        // The number of columns in each row of `inventory_grid_`
+        size_t cols_;
         
-        // A pointer to a dynamically allocated Item outside of the Player's bag
-        Item* equipped_;
+        // An owning pointer to a pool-allocated Item outside of the Player's bag
+        std::unique_ptr<Item> equipped_;
 
         // The total weight of all items in `inventory_grid_`
         float weight_; 
 
         // The total number of non-empty items in `inventory_grid_`
         size_t item_count_;
+
+        // The number and total weight of the items in `inventory_grid_` per ItemType,
+        // indexed by ItemType (NONE stays 0)
+        std::array<size_t, 4> type_counts_;
+        std::array<float, 4> type_weights_;
+
+        // The weight of the heaviest item in `inventory_grid_`, 0 if it holds none
+        float max_weight_;
+
+        /** A bitset of the non-NONE cells of `inventory_grid_`, 64 cells per word.
+        * Bit (i % 64) of word (i / 64) is set when cell i holds an item,
+        * so free cells are found a word at a time instead of by scanning Items.
+        */
+        std::pmr::vector<std::uint64_t> occupied_cells_;
+
+        /** A bitset of the cells written since the last drainChanges(), laid out like `occupied_cells_`.
+        * `dirty_words_` lists the words that hold at least one set bit, in the order they were
+        * first dirtied, so draining visits only the changed cells and never the whole grid.
+        */
+        std::pmr::vector<std::uint64_t> dirty_cells_;
+        std::pmr::vector<size_t> dirty_words_;
+
+        // True if `equipped_` changed since the last drainChanges()
+        bool equipped_dirty_;
+
+        /**
+         * @brief Maps a row and column to its offset in `inventory_grid_`.
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @return The offset of the cell in `inventory_grid_`.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        size_t cellIndex(const size_t& row, const size_t& col) const;
+
+        /**
+         * @brief Gives this Inventory its own copy of `inventory_grid_` if it is shared.
+         * @post `inventory_grid_` is referenced by this Inventory only and may be mutated.
+         * NOTE: Every member that writes to the grid must call this first.
+         */
+        void detachGrid();
+
+        /**
+         * @brief Sets or clears one cell's bit in `occupied_cells_`.
+         * @param index The offset of the cell in `inventory_grid_`.
+         * @param occupied True if the cell now holds a non-NONE item.
+         */
+        void markOccupied(size_t index, bool occupied);
+
+        /**
+         * @brief Records that a cell was written since the last checkpoint.
+         * @param index The offset of the cell in `inventory_grid_`.
+         * NOTE: Every member that writes a cell must call this.
+         */
+        void markDirty(size_t index);
+
+        /**
+         * @brief Finds the first free cell at or after an offset.
+         * @param start The offset in `inventory_grid_` to start searching from.
+         * @return The offset of the first NONE cell at or after `start`,
+         *  or `rows_ * cols_` if there is none.
+         */
+        size_t nextFreeIndex(size_t start) const;
+
+        /**
+         * @brief Adds an item that entered the grid to `type_counts_`, `type_weights_` and `max_weight_`.
+         * @param item A const ref. to the stored item. NONE items are not counted.
+         */
+        void tallyType(const Item& item);
+
+        /**
+         * @brief Removes an item that left the grid from `type_counts_`, `type_weights_` and `max_weight_`.
+         * @param item A const ref. to the removed item, which must no longer be in the grid.
+         * @note O(1), except that removing the heaviest item rescans the occupied cells
+         *  for the new maximum, which is O(cells).
+         */
+        void untallyType(const Item& item);
+
+        /**
+         * @brief Installs a flat grid and derives the bookkeeping members from it.
+         * @param cells The rows_ * cols_ cells of the grid in row-major order.
+         * @post Initializes `weight_`, `item_count_` and the per-type tables from the non-NONE cells
+         *  and marks those cells in `occupied_cells_`. No cell is marked dirty.
+         */
+        void adoptCells(std::vector<Item>&& cells);
+
+        /**
+         * @brief Moves an item into an empty cell and updates the bookkeeping members.
+         * @param index The offset of an empty cell in `inventory_grid_`.
+         * @param pickup An r-value ref. to the item to place.
+         * @post Updates `item_count_`, `weight_`, the per-type tables, `occupied_cells_` and marks the cell dirty.
+         *  A NONE pickup changes nothing, since the cell stays empty.
+         */
+        void placeAt(size_t index, Item&& pickup);
+
+        /**
+         * @brief Moves the grid and the bitsets to another memory resource.
+         * @param resource The resource to allocate from from now on.
+         * @post A grid shared with other Inventories is copied; an unshared one has its Items moved.
+         *  If an allocation throws, this Inventory is left unchanged.
+         */
+        void rehome(std::pmr::memory_resource* resource);
+
+        /**
+         * @brief Takes over the grid, bitsets and totals of an Inventory on an equal memory resource.
+         * @param source An l-value ref. to the Inventory to empty.
+         * @post `source` is left in the valid empty state of a moved-from Inventory.
+         *  Assigning `equipped_` destroys the overridden item.
+         */
+        void takeStorage(Inventory& source) noexcept;
     public:
         /**
          * @brief Constructor with optional parameters for initialization.
          * @param items A const reference to a 2D vector of items. 
          *  Defaults to a 10x10 grid of default-constructed items, if none provided.
-         * @param equipped A pointer to an Item object. 
-         *  Defaults to nullptr, if none provided.
+         * @param equipped A pointer to an Item object allocated with `new`.
+         *  The Inventory takes ownership of it. Defaults to nullptr, if none provided.
          * 
          * @post Initializes members in the following way:
          * 1) Initializes `weight_` as the total weight of all items in `items` (excluding NONE type) 
          * 2) Initialies `item_count_` as the count of non-NONE items. 
          * 
          * NOTE: The `equipped` item is excluded from these calculations.
+         * @param alloc The allocator whose memory resource backs the grid. Defaults to the default resource.
+         * @throws std::invalid_argument If the rows of `items` differ in length.
          */
         Inventory(
             const std::vector<std::vector<Item>>& items = 
                 std::vector(10, std::vector<Item>(10, Item{})),
-            Item* equipped = nullptr
+            Item* equipped = nullptr,
+            const allocator_type& alloc = allocator_type()
             );
 
+        /**
+         * @brief Constructor that moves the items out of a pre-built grid.
+         * @param items An r-value reference to a 2D vector of items, left with moved-from Items.
+         * @param equipped A pointer to an Item object allocated with `new`.
+         *  The Inventory takes ownership of it. Defaults to nullptr, if none provided.
+         *
+         * @param alloc The allocator whose memory resource backs the grid. Defaults to the default resource.
+         *
+         * @post Initializes `weight_` and `item_count_` as the 2D vector constructor does.
+         * @throws std::invalid_argument If the rows of `items` differ in length.
+         */
+        Inventory(std::vector<std::vector<Item>>&& items, Item* equipped = nullptr,
+                  const allocator_type& alloc = allocator_type());
+
+        /**
+         * @brief Constructor that takes over a flat, row-major grid.
+         * @param rows The number of rows in the grid.
+         * @param cols The number of columns in each row of the grid.
+         * @param cells The rows * cols cells in row-major order. Pass an r-value to avoid copying.
+         * @param equipped A pointer to an Item object allocated with `new`.
+         *  The Inventory takes ownership of it. Defaults to nullptr, if none provided.
+         *
+         * @param alloc The allocator whose memory resource backs the grid. Defaults to the default resource.
+         *
+         * @post Initializes `weight_` and `item_count_` as the 2D vector constructor does.
+         * @throws std::invalid_argument If `cells` does not hold exactly rows * cols items.
+         */
+        Inventory(size_t rows, size_t cols, std::vector<Item> cells, Item* equipped = nullptr,
+                  const allocator_type& alloc = allocator_type());
+
+        /**
+         * @brief Retrieves the allocator for `resource_`
+         * @return The allocator that the grid and bitsets are allocated with
+         */
+        allocator_type get_allocator() const;
+
         /** 
          * @brief Retrieves the value stored in `equipped_`
          * @return The Item pointer stored in `equipped_`
@@ -47,9 +236,10 @@ class Inventory {
 
         /**
          * @brief Equips a new item.
-         * @param itemToEquip A pointer to the item to equip.
-         * @post Updates `equipped` to the specified item 
-         * without deallocating the original.
+         * @param itemToEquip A pointer to the item to equip, allocated with `new`.
+         * @post Updates `equipped` to the specified item and takes ownership of it,
+         * without deallocating the original. Ownership of the original passes
+         * back to the caller.
          */
         void equip(Item* itemToEquip);
 
@@ -61,11 +251,37 @@ class Inventory {
         void discardEquipped();
 
         /** 
-         * @brief Retrieves the value stored in `inventory_grid_`
-         * @return The vector<vector<Item>> value stored in `inventory_grid_`
+         * @brief Retrieves the items stored in `inventory_grid_`
+         * @return A vector<vector<Item>> with one inner vector per row of `inventory_grid_`
          */
         std::vector<std::vector<Item>> getItems() const;
 
+        /**
+         * @brief Exposes `inventory_grid_` without copying it.
+         * @return A read-only GridView over the grid, with row and cell access.
+         * @note The view is invalidated by any later mutation of this Inventory.
+         */
+        GridView view() const;
+
+        /**
+         * @brief Exposes the occupied cells of `inventory_grid_` without copying them.
+         * @return A range over the non-NONE cells with their row and column, in row-major order.
+         * @note The range is invalidated by any later mutation of this Inventory.
+         */
+        OccupiedCells occupied() const;
+
+        /**
+         * @brief Retrieves the value stored in `rows_`
+         * @return The number of rows in the inventory grid
+         */
+        size_t getRows() const;
+
+        /**
+         * @brief Retrieves the value stored in `cols_`
+         * @return The number of columns in each row of the inventory grid
+         */
+        size_t getCols() const;
+
         /** 
          * @brief Retrieves the value stored in `weight_`
          * @return The float value stored in `weight_`
@@ -78,6 +294,26 @@ class Inventory {
          */
         size_t getCount() const;
 
+        /**
+         * @brief Retrieves the number of items of one type, kept up to date on every store
+         * @param type The ItemType to count.
+         * @return The value stored in `type_counts_[type]`; 0 for NONE
+         */
+        size_t getCount(ItemType type) const;
+
+        /**
+         * @brief Retrieves the total weight of the items of one type, kept up to date on every store
+         * @param type The ItemType to weigh.
+         * @return The value stored in `type_weights_[type]`; 0 for NONE
+         */
+        float getWeight(ItemType type) const;
+
+        /**
+         * @brief Retrieves the weight of the heaviest item in the grid, excluding the equipped item
+         * @return The value stored in `max_weight_`; 0 for an empty grid
+         */
+        float getMaxItemWeight() const;
+
         /**
          * @brief Retrieves the item located at the specified row and column
          * in the inventory grid.
@@ -102,6 +338,123 @@ class Inventory {
          */
         bool store(const size_t& row, const size_t& col, const Item& pickup);
 
+        /**
+         * @brief Stores an item at the specified row and column, moving it into the cell.
+         *
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col  A size_t parameter for the column index in the inventory grid.
+         * @param pickup An r-value ref. to the item to store. It is only moved from if stored.
+         * @return True if the item was successfully stored, false if the cell is already occupied.
+         * 
+         * @post Updates `item_count_` and `weight_` if the Item is sucessfully added
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        bool store(const size_t& row, const size_t& col, Item&& pickup);
+
+        /**
+         * @brief Constructs an item directly in the specified cell of the inventory grid.
+         *
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col  A size_t parameter for the column index in the inventory grid.
+         * @param name The name of the new item. Pass an r-value to avoid copying it.
+         * @param weight A float representing the weight of the new item.
+         * @param type An ItemType specifying the type of the new item.
+         * @return True if the item was successfully stored, false if the cell is already occupied.
+         * 
+         * @post Updates `item_count_` and `weight_` if the Item is sucessfully added
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        bool emplace(const size_t& row, const size_t& col, std::string name, float weight, ItemType type);
+
+        /**
+         * @brief Finds the first empty cell in row-major order.
+         * @return The (row, col) of the first NONE cell, or std::nullopt if the grid is full.
+         */
+        std::optional<std::pair<size_t, size_t>> findFreeSlot() const;
+
+        /**
+         * @brief Stores an item in the first empty cell.
+         * @param pickup A const ref. to the item to store.
+         * @return The (row, col) where the item was stored, or std::nullopt if the grid is full.
+         * 
+         * @post Updates `item_count_` and `weight_` if the Item is sucessfully added
+         */
+        std::optional<std::pair<size_t, size_t>> autoStore(const Item& pickup);
+
+        /**
+         * @brief Stores a batch of items in first-fit order.
+         * @param pickups A const ref. to the items to store, placed in order.
+         * @return One entry per element of `pickups`: the (row, col) where it was stored,
+         *  or std::nullopt if the grid was already full or the pickup is a NONE item,
+         *  which is not stored and leaves its cell free for the next pickup.
+         * 
+         * @post Updates `item_count_` and `weight_` once for the whole batch,
+         *  and the per-type tables per placed item.
+         */
+        std::vector<std::optional<std::pair<size_t, size_t>>> storeMany(const std::vector<Item>& pickups);
+
+        /**
+         * @brief Removes the item from the specified cell.
+         *
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @return The removed item, moved out of the cell, or a NONE Item if the cell was empty.
+         *
+         * @post Updates `item_count_`, `weight_` and the per-type tables and marks the cell dirty
+         *  if an item was removed.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         * @note O(1), unless the removed item was the heaviest in the grid: `max_weight_`
+         *  is then recomputed by rescanning every occupied cell, O(cells).
+         */
+        Item take(const size_t& row, const size_t& col);
+
+        /**
+         * @brief Moves an item into an empty cell of the same grid.
+         *
+         * @param fromRow The row index of the cell holding the item.
+         * @param fromCol The column index of the cell holding the item.
+         * @param toRow The row index of the empty destination cell.
+         * @param toCol The column index of the empty destination cell.
+         * @return True if the item was moved, false if the source is empty or the destination is occupied.
+         *
+         * @post The item is relocated without copying it; `weight_`, `item_count_` and
+         *  the per-type tables are unchanged. Both cells are marked dirty.
+         * @throws std::out_of_range If either cell is out of bounds.
+         */
+        bool moveCell(const size_t& fromRow, const size_t& fromCol, const size_t& toRow, const size_t& toCol);
+
+        /**
+         * @brief Exchanges the contents of two cells, either of which may be empty.
+         *
+         * @param firstRow The row index of the first cell.
+         * @param firstCol The column index of the first cell.
+         * @param secondRow The row index of the second cell.
+         * @param secondCol The column index of the second cell.
+         *
+         * @post The items are relocated without copying them; `weight_`, `item_count_` and
+         *  the per-type tables are unchanged. Both cells are marked dirty unless they are the same cell.
+         * @throws std::out_of_range If either cell is out of bounds.
+         */
+        void swapCells(const size_t& firstRow, const size_t& firstCol, const size_t& secondRow, const size_t& secondCol);
+
+        /**
+         * @brief Checks whether anything changed since the last checkpoint.
+         * @return True if a cell was written or the equipped item changed since the
+         *  last drainChanges() (or since construction).
+         */
+        bool hasChanges() const;
+
+        /**
+         * @brief Collects the changes since the last checkpoint and starts a new one.
+         * @return The written cells in row-major order and whether the equipped item changed.
+         *  Read the current contents through view() or at().
+         *  A copy's checkpoint is the moment it was copied, including copy assignment.
+         * 
+         * @post No cell is dirty and `equipped_dirty_` is false.
+         * @note O(changes): only the bitset words that were dirtied are visited.
+         */
+        InventoryChanges drainChanges();
+
         // Big Five
 
         /**
@@ -110,9 +463,22 @@ class Inventory {
          * @post Creates a deep copy of `rhs`, 
          *  including duplicating the dynamically 
          *  allocated item in `equipped`.
+         *  The grid is shared with `rhs` until either side mutates it,
+         *  provided `rhs` uses the default memory resource; otherwise it is copied into it.
+         *  The copy starts a checkpoint of its own: none of the changes pending in `rhs`
+         *  are reported by its first drainChanges(). Moves carry the pending changes along.
          */
         Inventory(const Inventory& rhs);
 
+        /**
+         * @brief Allocator-extended copy constructor for the Inventory class.
+         * @param rhs A const l-value ref. to the Inventory object to copy.
+         * @param alloc The allocator whose memory resource backs the copy.
+         * @post As the copy constructor, except that the grid is shared only
+         *  if `rhs` uses the same memory resource as `alloc`.
+         */
+        Inventory(const Inventory& rhs, const allocator_type& alloc);
+
         /**
          * @brief Move constructor for the Inventory class.
          * @param rhs An r-value ref. to the Inventory object to move from.
@@ -124,7 +490,17 @@ class Inventory {
          * - All numerical values are set to 0
          * - All containers are cleared to have size 0
          */
-        Inventory(Inventory&& rhs);
+        Inventory(Inventory&& rhs) noexcept;
+
+        /**
+         * @brief Allocator-extended move constructor for the Inventory class.
+         * @param rhs An r-value ref. to the Inventory object to move from.
+         * @param alloc The allocator whose memory resource backs the new Inventory.
+         * @post As the move constructor when `rhs` uses the same memory resource as `alloc`,
+         *  so moves within one arena stay pointer swaps. Otherwise the grid and bitsets
+         *  are then re-allocated from `alloc`; if that throws, `rhs` is left unchanged.
+         */
+        Inventory(Inventory&& rhs, const allocator_type& alloc);
 
         /**
          * @brief Copy assignment operator for the Inventory class.
@@ -132,6 +508,8 @@ class Inventory {
          * @return A reference to the updated Inventory object.
          * @post Performs a deep copy of `rhs`, including 
          * re-allocating and copying the item in `equipped`.
+         * The grid is shared with `rhs` until either side mutates it.
+         * If the copy throws, this object is left unchanged.
          * 
          * NOTE: The resources of the overridden object
          * should be destroyed.
@@ -151,7 +529,10 @@ class Inventory {
          * - All containers are cleared to have size 0
          * 
          * NOTE: The resources of the overridden object
-         * should be destroyed.
+         * should be destroyed. This object keeps its own memory resource: the storage
+         * of `rhs` is taken over only if both resources compare equal. Otherwise, as
+         * std::pmr containers do for unequal allocators, the contents are copied onto
+         * this object's resource, and if that throws both objects are left unchanged.
          */
         Inventory& operator=(Inventory&& rhs);
 
@@ -160,4 +541,7 @@ class Inventory {
          * @post Deallocates any dynamically allocated resources.
          */
         ~Inventory();
-};
\ No newline at end of file
+};
+
+// std::vector only relocates elements by move when the move constructor cannot throw
+static_assert(std::is_nothrow_move_constructible<Inventory>::value, "Inventory must be nothrow movable");
\ No newline at end of file
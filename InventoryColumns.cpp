@@ -0,0 +1,242 @@
+#include "InventoryColumns.hpp"
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/**
+* @brief Sums the weights of the non-NONE cells in [0, count).
+* @param weights A pointer to the weight column.
+* @param types A pointer to the type column.
+* @param count The number of cells to scan.
+* @return The total weight of the scanned non-NONE cells.
+*/
+static float sumWeights(const float* weights, const std::uint8_t* types, size_t count) {
+    size_t i = 0;
+    float total = 0;
+#if defined(__AVX2__)
+    __m256 acc = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        __m256 w = _mm256_loadu_ps(weights + i);
+        __m256i t = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(types + i)));
+        __m256i isNone = _mm256_cmpeq_epi32(t, _mm256_setzero_si256());
+        acc = _mm256_add_ps(acc, _mm256_andnot_ps(_mm256_castsi256_ps(isNone), w));
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+    total = _mm_cvtss_f32(half);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    float32x4_t acc = vdupq_n_f32(0);
+    for (; i + 8 <= count; i += 8) {
+        uint16x8_t t = vmovl_u8(vld1_u8(types + i));
+        uint32x4_t noneLo = vceqq_u32(vmovl_u16(vget_low_u16(t)), vdupq_n_u32(0));
+        uint32x4_t noneHi = vceqq_u32(vmovl_u16(vget_high_u16(t)), vdupq_n_u32(0));
+        uint32x4_t wLo = vbicq_u32(vreinterpretq_u32_f32(vld1q_f32(weights + i)), noneLo);
+        uint32x4_t wHi = vbicq_u32(vreinterpretq_u32_f32(vld1q_f32(weights + i + 4)), noneHi);
+        acc = vaddq_f32(acc, vreinterpretq_f32_u32(wLo));
+        acc = vaddq_f32(acc, vreinterpretq_f32_u32(wHi));
+    }
+    total = vaddvq_f32(acc);
+#endif
+    // Scalar tail (and the whole scan when no vector unit is enabled)
+    for (; i < count; i++) {
+        if (types[i] != NONE) { total += weights[i]; }
+    }
+    return total;
+}
+
+/**
+* @brief Counts the cells in [0, count) whose type equals `type`.
+* @param types A pointer to the type column.
+* @param count The number of cells to scan.
+* @param type The type byte to count.
+* @return The number of matching cells.
+*/
+static size_t countType(const std::uint8_t* types, size_t count, std::uint8_t type) {
+    size_t i = 0;
+    size_t matches = 0;
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(type));
+    for (; i + 32 <= count; i += 32) {
+        __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(t, needle)));
+        matches += __builtin_popcount(mask);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8x16_t needle = vdupq_n_u8(type);
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t hits = vshrq_n_u8(vceqq_u8(vld1q_u8(types + i), needle), 7);
+        matches += vaddvq_u8(hits);
+    }
+#endif
+    for (; i < count; i++) {
+        if (types[i] == type) { matches++; }
+    }
+    return matches;
+}
+
+/**
+* @brief Finds the first NONE cell in [0, count).
+* @param types A pointer to the type column.
+* @param count The number of cells to scan.
+* @return The offset of the first NONE cell, or `count` if there is none.
+*/
+static size_t firstNone(const std::uint8_t* types, size_t count) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= count; i += 32) {
+        __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(t, _mm256_setzero_si256())));
+        if (mask) { return i + __builtin_ctz(mask); }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 16 <= count; i += 16) {
+        if (vmaxvq_u8(vceqq_u8(vld1q_u8(types + i), vdupq_n_u8(0)))) { break; }
+    }
+#endif
+    for (; i < count; i++) {
+        if (types[i] == NONE) { return i; }
+    }
+    return count;
+}
+
+/**
+* @brief Builds a structure-of-arrays copy of an inventory grid.
+* @param inventory A const ref. to the Inventory whose grid is split into columns.
+* @param names The NameTable used to intern item names.
+*  Defaults to the process-wide table, if none provided.
+*
+* @post `weights_`, `types_` and `name_ids_` hold one entry per grid cell
+* in row-major order. The equipped item is not part of the grid and is ignored.
+*/
+InventoryColumns::InventoryColumns(const Inventory& inventory, NameTable& names)
+        : rows_(inventory.getRows()), cols_(inventory.getCols()), names_(&names) {
+    weights_.reserve(rows_ * cols_);
+    types_.reserve(rows_ * cols_);
+    name_ids_.reserve(rows_ * cols_);
+    for (const Item& item : inventory.view().cells()) {
+        PackedItem cell = names.pack(item);
+        weights_.push_back(cell.weight_);
+        types_.push_back(static_cast<std::uint8_t>(cell.type_));
+        name_ids_.push_back(cell.name_id_);
+    }
+}
+
+/**
+* @brief Retrieves the value stored in `rows_`
+* @return The number of rows in the source grid
+*/
+size_t InventoryColumns::getRows() const {
+    return rows_;
+}
+
+/**
+* @brief Retrieves the value stored in `cols_`
+* @return The number of columns in the source grid
+*/
+size_t InventoryColumns::getCols() const {
+    return cols_;
+}
+
+/**
+* @brief Retrieves the weight column
+* @return A const ref. to `weights_`
+*/
+const std::vector<float>& InventoryColumns::getWeights() const {
+    return weights_;
+}
+
+/**
+* @brief Retrieves the type column
+* @return A const ref. to `types_`
+*/
+const std::vector<std::uint8_t>& InventoryColumns::getTypes() const {
+    return types_;
+}
+
+/**
+* @brief Retrieves the name id column
+* @return A const ref. to `name_ids_`
+*/
+const std::vector<std::uint32_t>& InventoryColumns::getNameIds() const {
+    return name_ids_;
+}
+
+/**
+* @brief Retrieves the name assigned to an id
+* @param id An id taken from the name id column.
+* @return A const ref. to the name for `id`.
+* @throws std::out_of_range If `id` was not issued by the columns' NameTable.
+*/
+const std::string& InventoryColumns::getName(std::uint32_t id) const {
+    return names_->getName(id);
+}
+
+/**
+* @brief Retrieves one cell in its packed form, read straight from the columns.
+* @param row A size_t parameter for the row index in the source grid.
+* @param col A size_t parameter for the column index in the source grid.
+* @return The cell as a PackedItem whose handle belongs to the columns' NameTable.
+* @throws std::out_of_range If the row or column is out of bounds.
+*/
+PackedItem InventoryColumns::getCell(size_t row, size_t col) const {
+    if (row >= rows_ || col >= cols_) { throw std::out_of_range("Invalid inventory index."); }
+    size_t offset = row * cols_ + col;
+    return PackedItem{name_ids_[offset], weights_[offset], static_cast<ItemType>(types_[offset])};
+}
+
+/**
+* @brief Retrieves one cell as an Item, unpacked through the columns' NameTable.
+* @param row A size_t parameter for the row index in the source grid.
+* @param col A size_t parameter for the column index in the source grid.
+* @return An Item equal to the source grid's cell at (row, col).
+* @throws std::out_of_range If the row or column is out of bounds.
+*/
+Item InventoryColumns::getItem(size_t row, size_t col) const {
+    return names_->unpack(getCell(row, col));
+}
+
+/**
+* @brief Sums the weight of every non-NONE cell.
+* @return The total weight, matching Inventory::getWeight() up to
+*  floating-point reassociation in the vectorized kernels.
+*/
+float InventoryColumns::totalWeight() const {
+    return sumWeights(weights_.data(), types_.data(), types_.size());
+}
+
+/**
+* @brief Counts the cells holding a given ItemType.
+* @param type The ItemType to count.
+* @return The number of cells whose type is `type`.
+*/
+size_t InventoryColumns::countByType(ItemType type) const {
+    return countType(types_.data(), types_.size(), static_cast<std::uint8_t>(type));
+}
+
+/**
+* @brief Counts the cells of every ItemType.
+* @return An array indexed by ItemType holding the number of cells of each type.
+*/
+std::array<size_t, 4> InventoryColumns::countAllTypes() const {
+    std::array<size_t, 4> counts{};
+    counts[WEAPON] = countByType(WEAPON);
+    counts[ACCESSORY] = countByType(ACCESSORY);
+    counts[ARMOR] = countByType(ARMOR);
+    counts[NONE] = types_.size() - counts[WEAPON] - counts[ACCESSORY] - counts[ARMOR];
+    return counts;
+}
+
+/**
+* @brief Finds the first empty (NONE) cell in row-major order.
+* @return The (row, col) of the first empty cell, or std::nullopt if the grid is full.
+*/
+std::optional<std::pair<size_t, size_t>> InventoryColumns::findFirstEmpty() const {
+    size_t offset = firstNone(types_.data(), types_.size());
+    if (offset == types_.size()) { return std::nullopt; }
+    return std::make_pair(offset / cols_, offset % cols_);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Inventory.hpp"
+#include "NameTable.hpp"
+
+class InventoryColumns {
+    private:
+        // The number of rows in the source inventory grid
+        size_t rows_;
+
+        // The number of columns in each row of the source inventory grid
+        size_t cols_;
+
+        // The weight of every cell, in row-major order
+        std::vector<float> weights_;
+
+        // The ItemType of every cell, narrowed to one byte, in row-major order
+        std::vector<std::uint8_t> types_;
+
+        // The NameTable handle of every cell's name, in row-major order
+        std::vector<std::uint32_t> name_ids_;
+
+        // The table that issued the handles in `name_ids_`
+        const NameTable* names_;
+    public:
+        /**
+         * @brief Builds a structure-of-arrays copy of an inventory grid.
+         * @param inventory A const ref. to the Inventory whose grid is split into columns.
+         * @param names The NameTable used to intern item names.
+         *  Defaults to the process-wide table, if none provided.
+         *
+         * @post `weights_`, `types_` and `name_ids_` hold one entry per grid cell
+         * in row-major order. The equipped item is not part of the grid and is ignored.
+         */
+        explicit InventoryColumns(const Inventory& inventory, NameTable& names = NameTable::global());
+
+        /**
+         * @brief Retrieves the value stored in `rows_`
+         * @return The number of rows in the source grid
+         */
+        size_t getRows() const;
+
+        /**
+         * @brief Retrieves the value stored in `cols_`
+         * @return The number of columns in the source grid
+         */
+        size_t getCols() const;
+
+        /**
+         * @brief Retrieves the weight column
+         * @return A const ref. to `weights_`
+         */
+        const std::vector<float>& getWeights() const;
+
+        /**
+         * @brief Retrieves the type column
+         * @return A const ref. to `types_`
+         */
+        const std::vector<std::uint8_t>& getTypes() const;
+
+        /**
+         * @brief Retrieves the name id column
+         * @return A const ref. to `name_ids_`
+         */
+        const std::vector<std::uint32_t>& getNameIds() const;
+
+        /**
+         * @brief Retrieves the name assigned to an id
+         * @param id An id taken from the name id column.
+         * @return A const ref. to the name for `id`.
+         * @throws std::out_of_range If `id` was not issued by the columns' NameTable.
+         */
+        const std::string& getName(std::uint32_t id) const;
+
+        /**
+         * @brief Retrieves one cell in its packed form, read straight from the columns.
+         * @param row A size_t parameter for the row index in the source grid.
+         * @param col A size_t parameter for the column index in the source grid.
+         * @return The cell as a PackedItem whose handle belongs to the columns' NameTable.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        PackedItem getCell(size_t row, size_t col) const;
+
+        /**
+         * @brief Retrieves one cell as an Item, unpacked through the columns' NameTable.
+         * @param row A size_t parameter for the row index in the source grid.
+         * @param col A size_t parameter for the column index in the source grid.
+         * @return An Item equal to the source grid's cell at (row, col).
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        Item getItem(size_t row, size_t col) const;
+
+        /**
+         * @brief Sums the weight of every non-NONE cell.
+         * @return The total weight, matching Inventory::getWeight() up to
+         *  floating-point reassociation in the vectorized kernels.
+         */
+        float totalWeight() const;
+
+        /**
+         * @brief Counts the cells holding a given ItemType.
+         * @param type The ItemType to count.
+         * @return The number of cells whose type is `type`.
+         */
+        size_t countByType(ItemType type) const;
+
+        /**
+         * @brief Counts the cells of every ItemType.
+         * @return An array indexed by ItemType holding the number of cells of each type.
+         */
+        std::array<size_t, 4> countAllTypes() const;
+
+        /**
+         * @brief Finds the first empty (NONE) cell in row-major order.
+         * @return The (row, col) of the first empty cell, or std::nullopt if the grid is full.
+         */
+        std::optional<std::pair<size_t, size_t>> findFirstEmpty() const;
+};
@@ -1,13 +1,14 @@
 #include "Item.hpp"
+#include "ItemPool.hpp"
 
 /**
  * @brief Constructs a new Item object.
- * @param name A const. ref to a string representing the name of the item.
+ * @param name A string representing the name of the item. Pass an r-value to avoid copying it.
  * @param weight A const. ref to a float representing the weight of the item.
  * @param type A const ref. to an ItemType specifying the type of the item.
  */
-Item::Item(const std::string& name, const float& weight, const ItemType& type) 
-    : name_{name}, weight_{weight}, type_{type}{}
+Item::Item(std::string name, const float& weight, const ItemType& type) 
+    : name_{std::move(name)}, weight_{weight}, type_{type}{}
 
 /**
  * @brief Checks if two Item objects are equal
@@ -19,4 +20,46 @@ Item::Item(const std::string& name, const float& weight, const ItemType& type)
  */
 bool Item::operator==(const Item& rhs) const {
     return name_ == rhs.name_ && weight_ == rhs.weight_ && type_ == rhs.type_;
+}
+
+/**
+ * @brief Allocates a single heap Item from the calling thread's ItemPool.
+ * NOTE: Only `new Item` is pooled; Items stored by value in containers
+ *       keep using the container's allocator.
+ *
+ * @param size The number of bytes requested.
+ * @return A pointer to storage for the Item.
+ * @throws std::bad_alloc If the storage cannot be allocated.
+ */
+void* Item::operator new(std::size_t size) {
+    Instrumentation::record(Instrumentation::EQUIPPED_ALLOCATED);
+    // Anything larger than an Item (e.g. a derived type) is not pool-sized
+    if (size != sizeof(Item)) { return ::operator new(size); }
+    return ItemPool::acquire();
+}
+
+/**
+ * @brief Returns a heap Item's storage to the ItemPool.
+ * @param ptr A pointer obtained from Item::operator new, or nullptr.
+ * @param size The number of bytes originally requested.
+ */
+void Item::operator delete(void* ptr, std::size_t size) noexcept {
+    if (ptr) { Instrumentation::record(Instrumentation::EQUIPPED_FREED); }
+    if (size != sizeof(Item)) {
+        ::operator delete(ptr);
+        return;
+    }
+    ItemPool::release(ptr);
+}
+
+/**
+ * @brief Checks if two PackedItem objects are equal
+ * NOTE: Handles from the same NameTable are equal exactly when the names are,
+ *       so this matches Item::operator== without comparing any characters.
+ *
+ * @param rhs The other PackedItem object to compare with.
+ * @return True if the handles, weights, and types are equal, false otherwise.
+ */
+bool PackedItem::operator==(const PackedItem& rhs) const {
+    return name_id_ == rhs.name_id_ && weight_ == rhs.weight_ && type_ == rhs.type_;
 }
\ No newline at end of file
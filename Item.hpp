@@ -1,22 +1,27 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <type_traits>
+#include "Instrumentation.hpp"
 
 enum ItemType { NONE=0, WEAPON=1, ACCESSORY=2, ARMOR=3};
 
-struct Item {
+// Counts its own copies and moves when built with MMORPG_INSTRUMENT
+struct Item : CountedInstance<Instrumentation::ITEM_CONSTRUCTED> {
     std::string name_; // The name of the Item
     float weight_;     // A float representing the weight of the Item
     ItemType type_;    // An enum representing the type of Item
     
      /**
      * @brief Constructs a new Item object.
-     * @param name A const. ref to a string representing the name of the item.
+     * @param name A string representing the name of the item. Pass an r-value to avoid copying it.
      * @param weight A const. ref to a float representing the weight of the item.
      * @param type A const ref. to an ItemType specifying the type of the item.
      */
-    Item(const std::string& name="", const float& weight = 0, const ItemType& type = NONE);
+    Item(std::string name = "", const float& weight = 0, const ItemType& type = NONE);
 
     /**
      * @brief Checks if two Item objects are equal
@@ -27,4 +32,47 @@ struct Item {
      * @return True if the two Item objects are equal, false otherwise.
      */
     bool operator==(const Item& rhs) const;
-};
\ No newline at end of file
+
+    /**
+     * @brief Allocates a single heap Item from the calling thread's ItemPool.
+     * NOTE: Only `new Item` is pooled; Items stored by value in containers
+     *       keep using the container's allocator.
+     *
+     * @param size The number of bytes requested.
+     * @return A pointer to storage for the Item.
+     * @throws std::bad_alloc If the storage cannot be allocated.
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * @brief Returns a heap Item's storage to the ItemPool.
+     * @param ptr A pointer obtained from Item::operator new, or nullptr.
+     * @param size The number of bytes originally requested.
+     */
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+};
+
+static_assert(std::is_nothrow_move_constructible<Item>::value, "Item must be nothrow movable");
+
+/**
+ * @brief A fixed-size Item whose name is a handle into a NameTable.
+ * Copying a PackedItem never allocates, so a grid of them copies as plain memory.
+ * Use NameTable::pack and NameTable::unpack to convert to and from Item.
+ */
+struct PackedItem {
+    std::uint32_t name_id_; // The NameTable handle of the Item's name
+    float weight_;          // A float representing the weight of the Item
+    ItemType type_;         // An enum representing the type of Item
+
+    /**
+     * @brief Checks if two PackedItem objects are equal
+     * NOTE: Handles from the same NameTable are equal exactly when the names are,
+     *       so this matches Item::operator== without comparing any characters.
+     *
+     * @param rhs The other PackedItem object to compare with.
+     * @return True if the handles, weights, and types are equal, false otherwise.
+     */
+    bool operator==(const PackedItem& rhs) const;
+};
+
+static_assert(std::is_trivially_copyable<PackedItem>::value, "PackedItem must stay memcpy-able");
\ No newline at end of file
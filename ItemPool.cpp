@@ -0,0 +1,162 @@
+#include "ItemPool.hpp"
+#include <mutex>
+#include <new> // For ::operator new
+
+/**
+ * @brief Free blocks handed over by threads that have exited or are holding too many.
+ * Only touched when a pool exits, runs dry or spills, never on the steady-state path.
+ */
+static std::mutex orphan_mutex;
+static void* orphan_list = nullptr;
+
+/**
+ * @brief Whether the calling thread's pool has been destroyed.
+ * A trivially destructible thread_local, so it stays readable after the pool itself is gone.
+ */
+static thread_local bool pool_destroyed = false;
+
+/**
+ * @brief Constructs an empty pool for the calling thread.
+ */
+ItemPool::ItemPool() : free_list_(nullptr), free_count_(0), stats_{0, 0, 0, 0, 0} {}
+
+/**
+ * @brief Hands this thread's free blocks to the shared list.
+ * NOTE: Slabs are never returned to the global allocator, since
+ *  blocks from them may still be alive on other threads.
+ */
+ItemPool::~ItemPool() {
+    pool_destroyed = true;
+    if (!free_list_) { return; }
+    Block* tail = free_list_;
+    while (tail->next) { tail = tail->next; }
+
+    std::lock_guard<std::mutex> lock(orphan_mutex);
+    tail->next = static_cast<Block*>(orphan_list);
+    orphan_list = free_list_;
+    free_list_ = nullptr;
+    free_count_ = 0;
+}
+
+/**
+ * @brief Retrieves the calling thread's pool.
+ * @return A reference to the thread_local ItemPool.
+ */
+ItemPool& ItemPool::local() {
+    thread_local ItemPool pool;
+    return pool;
+}
+
+/**
+ * @brief Pushes a block onto the shared list.
+ * @param block A pointer to Item-sized block storage.
+ * @note Used for frees that arrive after the calling thread's pool was destroyed.
+ */
+void ItemPool::orphan(Block* block) noexcept {
+    std::lock_guard<std::mutex> lock(orphan_mutex);
+    block->next = static_cast<Block*>(orphan_list);
+    orphan_list = block;
+}
+
+/**
+ * @brief Allocates storage for one Item from the calling thread's pool.
+ * @return A pointer to uninitialized storage of sizeof(Item) bytes.
+ * @throws std::bad_alloc If the storage cannot be allocated.
+ * @note Falls back to the global allocator once the thread's pool has been
+ *  destroyed, e.g. for Items created by static destructors.
+ */
+void* ItemPool::acquire() {
+    if (pool_destroyed) { return ::operator new(sizeof(Block)); }
+    return local().allocate();
+}
+
+/**
+ * @brief Returns storage obtained from `acquire` on any thread.
+ * @param ptr A pointer previously returned by `acquire`, or nullptr.
+ */
+void ItemPool::release(void* ptr) noexcept {
+    if (!ptr) { return; }
+    if (pool_destroyed) {
+        orphan(static_cast<Block*>(ptr));
+    } else {
+        local().deallocate(ptr);
+    }
+}
+
+/**
+ * @brief Refills `free_list_`, first from the shared list of free blocks,
+ *  otherwise with a new slab from the global allocator.
+ */
+void ItemPool::refill() {
+    {
+        std::lock_guard<std::mutex> lock(orphan_mutex);
+        if (orphan_list) {
+            free_list_ = static_cast<Block*>(orphan_list);
+            orphan_list = nullptr;
+            for (Block* block = free_list_; block; block = block->next) { free_count_++; }
+            stats_.adopted_blocks += free_count_;
+            return;
+        }
+    }
+
+    Block* slab = static_cast<Block*>(::operator new(sizeof(Block) * BLOCKS_PER_SLAB));
+    stats_.slab_allocations++;
+    for (size_t i = 0; i < BLOCKS_PER_SLAB; i++) {
+        slab[i].next = (i + 1 < BLOCKS_PER_SLAB) ? &slab[i + 1] : nullptr;
+    }
+    free_list_ = slab;
+    free_count_ = BLOCKS_PER_SLAB;
+}
+
+/**
+ * @brief Moves BLOCKS_PER_SLAB blocks from the head of `free_list_` to the shared list.
+ */
+void ItemPool::spill() noexcept {
+    Block* head = free_list_;
+    Block* tail = head;
+    for (size_t i = 1; i < BLOCKS_PER_SLAB; i++) { tail = tail->next; }
+    free_list_ = tail->next;
+    free_count_ -= BLOCKS_PER_SLAB;
+    stats_.spilled_blocks += BLOCKS_PER_SLAB;
+
+    std::lock_guard<std::mutex> lock(orphan_mutex);
+    tail->next = static_cast<Block*>(orphan_list);
+    orphan_list = head;
+}
+
+/**
+ * @brief Allocates storage for one Item.
+ * @return A pointer to uninitialized storage of sizeof(Item) bytes.
+ * @throws std::bad_alloc If a new slab is needed and cannot be allocated.
+ */
+void* ItemPool::allocate() {
+    if (!free_list_) { refill(); }
+    Block* block = free_list_;
+    free_list_ = block->next;
+    free_count_--;
+    stats_.allocations++;
+    return block->storage;
+}
+
+/**
+ * @brief Returns storage obtained from `allocate` on any thread.
+ * @param ptr A pointer previously returned by `allocate`, or nullptr.
+ * @note Past MAX_FREE_BLOCKS, a slab's worth of blocks is spilled to the shared list.
+ */
+void ItemPool::deallocate(void* ptr) noexcept {
+    if (!ptr) { return; }
+    Block* block = static_cast<Block*>(ptr);
+    block->next = free_list_;
+    free_list_ = block;
+    free_count_++;
+    stats_.deallocations++;
+    if (free_count_ > MAX_FREE_BLOCKS) { spill(); }
+}
+
+/**
+ * @brief Retrieves the counters of the calling thread's pool.
+ * @return A copy of `stats_`.
+ */
+ItemPool::Stats ItemPool::getStats() const {
+    return stats_;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include "Item.hpp"
+
+class ItemPool {
+    public:
+        /**
+         * @brief Allocation counters for one thread's pool.
+         */
+        struct Stats {
+            size_t allocations;      // Blocks handed out by `allocate`
+            size_t deallocations;    // Blocks returned through `deallocate`
+            size_t slab_allocations; // Slabs requested from the global allocator
+            size_t adopted_blocks;   // Free blocks taken over from the shared list
+            size_t spilled_blocks;   // Free blocks handed to the shared list while this thread ran
+        };
+
+    private:
+        // A free block reuses the storage of the Item it will hold to link the free list
+        union Block {
+            Block* next;
+            alignas(Item) unsigned char storage[sizeof(Item)];
+        };
+
+        // The number of Item-sized blocks carved out of each slab
+        static constexpr size_t BLOCKS_PER_SLAB = 64;
+
+        // The most free blocks a thread keeps before spilling a slab's worth to the shared list,
+        // so blocks freed by a consumer thread flow back to the thread that allocates them
+        static constexpr size_t MAX_FREE_BLOCKS = 4 * BLOCKS_PER_SLAB;
+
+        // The head of this thread's list of free blocks
+        Block* free_list_;
+
+        // The number of blocks on `free_list_`
+        size_t free_count_;
+
+        // The counters reported by `getStats`
+        Stats stats_;
+
+        /**
+         * @brief Refills `free_list_`, first from the shared list of free blocks,
+         *  otherwise with a new slab from the global allocator.
+         */
+        void refill();
+
+        /**
+         * @brief Moves BLOCKS_PER_SLAB blocks from the head of `free_list_` to the shared list.
+         */
+        void spill() noexcept;
+
+        /**
+         * @brief Constructs an empty pool for the calling thread.
+         */
+        ItemPool();
+
+        /**
+         * @brief Pushes a block onto the shared list.
+         * @param block A pointer to Item-sized block storage.
+         * @note Used for frees that arrive after the calling thread's pool was destroyed.
+         */
+        static void orphan(Block* block) noexcept;
+
+    public:
+        /**
+         * @brief Hands this thread's free blocks to the shared list.
+         * NOTE: Slabs are never returned to the global allocator, since
+         *  blocks from them may still be alive on other threads.
+         */
+        ~ItemPool();
+
+        ItemPool(const ItemPool&) = delete;
+        ItemPool& operator=(const ItemPool&) = delete;
+
+        /**
+         * @brief Retrieves the calling thread's pool.
+         * @return A reference to the thread_local ItemPool.
+         */
+        static ItemPool& local();
+
+        /**
+         * @brief Allocates storage for one Item from the calling thread's pool.
+         * @return A pointer to uninitialized storage of sizeof(Item) bytes.
+         * @throws std::bad_alloc If the storage cannot be allocated.
+         * @note Falls back to the global allocator once the thread's pool has been
+         *  destroyed, e.g. for Items created by static destructors.
+         */
+        static void* acquire();
+
+        /**
+         * @brief Returns storage obtained from `acquire` on any thread.
+         * @param ptr A pointer previously returned by `acquire`, or nullptr.
+         */
+        static void release(void* ptr) noexcept;
+
+        /**
+         * @brief Allocates storage for one Item.
+         * @return A pointer to uninitialized storage of sizeof(Item) bytes.
+         * @throws std::bad_alloc If a new slab is needed and cannot be allocated.
+         */
+        void* allocate();
+
+        /**
+         * @brief Returns storage obtained from `allocate` on any thread.
+         * @param ptr A pointer previously returned by `allocate`, or nullptr.
+         * @note Past MAX_FREE_BLOCKS, a slab's worth of blocks is spilled to the shared list.
+         */
+        void deallocate(void* ptr) noexcept;
+
+        /**
+         * @brief Retrieves the counters of the calling thread's pool.
+         * @return A copy of `stats_`.
+         */
+        Stats getStats() const;
+};
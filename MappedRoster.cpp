@@ -0,0 +1,258 @@
+#include "MappedRoster.hpp"
+#include "Guild.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static constexpr std::uint8_t MAGIC[4] = {'M', 'G', 'R', 'S'};
+static constexpr size_t HEADER_SIZE = 16;
+static constexpr size_t INDEX_ENTRY_SIZE = 16;
+
+// The offset and length of the player name inside a PlayerCodec record header
+static constexpr size_t RECORD_NAME_LENGTH_OFFSET = 28;
+static constexpr size_t RECORD_NAME_OFFSET = 32;
+
+/**
+* @brief Reads a little-endian unsigned integer of `width` bytes.
+*/
+static std::uint64_t loadLE(const std::uint8_t* p, size_t width) {
+    std::uint64_t value = 0;
+    for (size_t byte = 0; byte < width; byte++) { value |= static_cast<std::uint64_t>(p[byte]) << (byte * 8); }
+    return value;
+}
+
+/**
+* @brief Appends a little-endian unsigned integer of `width` bytes.
+*/
+static void storeLE(std::vector<std::uint8_t>& out, std::uint64_t value, size_t width) {
+    for (size_t byte = 0; byte < width; byte++) { out.push_back(static_cast<std::uint8_t>(value >> (byte * 8))); }
+}
+
+/**
+* @brief Writes all of `bytes` to a file descriptor, retrying short writes.
+* @throws std::system_error If the write fails.
+*/
+static void writeAll(int fd, const std::uint8_t* bytes, size_t size, const std::string& path) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) { continue; }
+            throw std::system_error(errno, std::generic_category(), "Cannot write roster file " + path);
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+/**
+* @brief Flushes the directory holding `path`, so a rename into it survives a crash.
+* @throws std::system_error If the directory cannot be opened or flushed.
+*/
+static void syncParentDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) { throw std::system_error(errno, std::generic_category(), "Cannot open roster directory " + directory); }
+    if (::fsync(fd) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot sync roster directory " + directory);
+    }
+    ::close(fd);
+}
+
+/**
+* @brief Maps a roster file read-only.
+* @param path The path of a file produced by `write`.
+* @throws std::system_error If the file cannot be opened or mapped.
+* @throws std::invalid_argument If the file is not a roster or its index is truncated.
+*/
+MappedRoster::MappedRoster(const std::string& path) : data_(nullptr), size_(0), count_(0) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { throw std::system_error(errno, std::generic_category(), "Cannot open roster file " + path); }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot stat roster file " + path);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ < HEADER_SIZE) {
+        ::close(fd);
+        throw std::invalid_argument("Not a roster file: " + path);
+    }
+
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    int error = errno;
+    ::close(fd); // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) { throw std::system_error(error, std::generic_category(), "Cannot map roster file " + path); }
+    data_ = static_cast<const std::uint8_t*>(mapping);
+
+    if (std::memcmp(data_, MAGIC, sizeof(MAGIC)) != 0 || loadLE(data_ + 4, 2) != FORMAT_VERSION) {
+        ::munmap(mapping, size_);
+        throw std::invalid_argument("Not a roster file: " + path);
+    }
+    std::uint64_t count = loadLE(data_ + 8, 8);
+    if (count > (size_ - HEADER_SIZE) / INDEX_ENTRY_SIZE) {
+        ::munmap(mapping, size_);
+        throw std::invalid_argument("Truncated roster index: " + path);
+    }
+    count_ = static_cast<size_t>(count);
+}
+
+/**
+* @brief Unmaps the file. Views handed out by this roster become invalid.
+*/
+MappedRoster::~MappedRoster() {
+    ::munmap(const_cast<std::uint8_t*>(data_), size_);
+}
+
+/**
+* @brief Locates the record bytes of an index entry.
+* @param slot An index position in [0, getSize()).
+* @return The record's first byte and its length.
+* @throws std::invalid_argument If the entry points outside the mapping.
+*/
+std::pair<const std::uint8_t*, size_t> MappedRoster::recordBytes(size_t slot) const {
+    const std::uint8_t* entry = data_ + HEADER_SIZE + slot * INDEX_ENTRY_SIZE;
+    std::uint64_t offset = loadLE(entry, 8);
+    std::uint64_t size = loadLE(entry + 8, 8);
+    if (offset > size_ || size > size_ - offset) { throw std::invalid_argument("Corrupt roster index entry."); }
+    return {data_ + offset, static_cast<size_t>(size)};
+}
+
+/**
+* @brief Reads the player name of an index entry straight from its record header.
+* @param slot An index position in [0, getSize()).
+* @return A view of the name inside the mapping.
+* @throws std::invalid_argument If the record is too short to hold the name.
+*/
+std::string_view MappedRoster::nameAt(size_t slot) const {
+    auto [record, size] = recordBytes(slot);
+    if (size < RECORD_NAME_OFFSET) { throw std::invalid_argument("Corrupt roster record."); }
+    size_t length = static_cast<size_t>(loadLE(record + RECORD_NAME_LENGTH_OFFSET, 4));
+    if (length > size - RECORD_NAME_OFFSET) { throw std::invalid_argument("Corrupt roster record."); }
+    return std::string_view(reinterpret_cast<const char*>(record + RECORD_NAME_OFFSET), length);
+}
+
+/**
+* @brief Retrieves the number of players in the file
+* @return The value stored in `count_`
+*/
+size_t MappedRoster::getSize() const {
+    return count_;
+}
+
+/**
+* @brief Searches the index for a player by name.
+* @param playerName The name to look for.
+* @return The player's index position, or std::nullopt if the file does not hold them.
+* @note O(log P); only the names of the probed records are touched.
+*/
+std::optional<size_t> MappedRoster::find(std::string_view playerName) const {
+    size_t low = 0;
+    size_t high = count_;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int order = nameAt(middle).compare(playerName);
+        if (order == 0) { return middle; }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+* @brief Views the record of an index entry in place.
+* @param slot An index position in [0, getSize()).
+* @return A RecordView over the mapped bytes, valid for the roster's lifetime.
+* @throws std::out_of_range If `slot` is not in the index.
+* @throws std::invalid_argument If the record is malformed.
+*/
+PlayerCodec::RecordView MappedRoster::getRecord(size_t slot) const {
+    if (slot >= count_) { throw std::out_of_range("Invalid roster index."); }
+    auto [record, size] = recordBytes(slot);
+    return PlayerCodec::RecordView(record, size);
+}
+
+/**
+* @brief Writes every player of a guild to a roster file.
+* @param guild A const ref. to the Guild to save. Materialized players are encoded;
+*  cold players and those still only in the guild's attached roster are copied over byte for byte.
+* @param path The file to create or replace. It is written to `path + ".tmp"`
+*  first and renamed over `path`, so readers never see a partial file.
+*  The file and its directory are flushed to disk before `write` returns.
+* @throws std::system_error If the file cannot be written.
+*/
+void MappedRoster::write(const Guild& guild, const std::string& path) {
+    struct Entry {
+        std::string_view name;
+        const std::uint8_t* bytes;
+        size_t size;
+    };
+
+    // Encoded records must stay alive until they are written
+    std::vector<std::vector<std::uint8_t>> encoded;
+    encoded.reserve(guild.enlisted_players.size());
+    std::vector<Entry> entries;
+    for (const Player& player : guild.enlisted_players) {
+        encoded.push_back(PlayerCodec::encode(player));
+        entries.push_back(Entry{player.getNameView(), encoded.back().data(), encoded.back().size()});
+    }
+    for (const auto& cold : guild.cold_players_) {
+        entries.push_back(Entry{cold.first, cold.second.record.data(), cold.second.record.size()});
+    }
+    if (guild.mapped_roster_) {
+        const MappedRoster& roster = *guild.mapped_roster_;
+        for (size_t slot = 0; slot < roster.getSize(); slot++) {
+            if (guild.mapped_claimed_[slot]) { continue; }
+            auto [record, size] = roster.recordBytes(slot);
+            entries.push_back(Entry{roster.nameAt(slot), record, size});
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.name < rhs.name; });
+
+    std::vector<std::uint8_t> prologue;
+    prologue.reserve(HEADER_SIZE + entries.size() * INDEX_ENTRY_SIZE);
+    prologue.insert(prologue.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    storeLE(prologue, FORMAT_VERSION, 2);
+    storeLE(prologue, 0, 2);
+    storeLE(prologue, entries.size(), 8);
+    size_t offset = HEADER_SIZE + entries.size() * INDEX_ENTRY_SIZE;
+    for (const Entry& entry : entries) {
+        storeLE(prologue, offset, 8);
+        storeLE(prologue, entry.size, 8);
+        offset += entry.size;
+    }
+
+    std::string staging = path + ".tmp";
+    int fd = ::open(staging.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) { throw std::system_error(errno, std::generic_category(), "Cannot create roster file " + staging); }
+    try {
+        writeAll(fd, prologue.data(), prologue.size(), staging);
+        for (const Entry& entry : entries) { writeAll(fd, entry.bytes, entry.size, staging); }
+        // Flush the contents before the rename, or a crash could leave `path` naming an empty file
+        if (::fsync(fd) != 0) { throw std::system_error(errno, std::generic_category(), "Cannot sync roster file " + staging); }
+    } catch (...) {
+        ::close(fd);
+        ::unlink(staging.c_str());
+        throw;
+    }
+    if (::close(fd) != 0 || std::rename(staging.c_str(), path.c_str()) != 0) {
+        int error = errno;
+        ::unlink(staging.c_str());
+        throw std::system_error(error, std::generic_category(), "Cannot replace roster file " + path);
+    }
+    syncParentDirectory(path);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "PlayerCodec.hpp"
+
+class Guild;
+
+/** A guild roster file opened read-only through mmap(2).
+*
+* File layout (little-endian):
+*
+*     offset  size       field
+*          0     4       magic "MGRS"
+*          4     2       format version (FORMAT_VERSION)
+*          6     2       reserved, zero
+*          8     8       number of players P
+*         16     16 * P  index: per player a u64 record offset and u64 record size,
+*                        sorted by player name (bytewise)
+*          …             PlayerCodec SNAPSHOT records
+*
+* Opening a roster maps the file and checks the fixed header only, so it costs
+* the same for any number of players. Lookups binary search the index, and
+* each record is validated when it is first viewed. The mapping is shared by
+* every reader and is never written through.
+*/
+class MappedRoster {
+    private:
+        // The first byte of the mapping
+        const std::uint8_t* data_;
+
+        // The length of the mapping in bytes
+        size_t size_;
+
+        // The number of players in the index
+        size_t count_;
+
+        /**
+         * @brief Locates the record bytes of an index entry.
+         * @param slot An index position in [0, getSize()).
+         * @return The record's first byte and its length.
+         * @throws std::invalid_argument If the entry points outside the mapping.
+         */
+        std::pair<const std::uint8_t*, size_t> recordBytes(size_t slot) const;
+
+        /**
+         * @brief Reads the player name of an index entry straight from its record header.
+         * @param slot An index position in [0, getSize()).
+         * @return A view of the name inside the mapping.
+         * @throws std::invalid_argument If the record is too short to hold the name.
+         */
+        std::string_view nameAt(size_t slot) const;
+    public:
+        // The format version written into, and required from, every roster file
+        static constexpr std::uint16_t FORMAT_VERSION = 1;
+
+        /**
+         * @brief Maps a roster file read-only.
+         * @param path The path of a file produced by `write`.
+         * @throws std::system_error If the file cannot be opened or mapped.
+         * @throws std::invalid_argument If the file is not a roster or its index is truncated.
+         */
+        explicit MappedRoster(const std::string& path);
+
+        /**
+         * @brief Unmaps the file. Views handed out by this roster become invalid.
+         */
+        ~MappedRoster();
+
+        MappedRoster(const MappedRoster&) = delete;
+        MappedRoster& operator=(const MappedRoster&) = delete;
+
+        /**
+         * @brief Retrieves the number of players in the file
+         * @return The value stored in `count_`
+         */
+        size_t getSize() const;
+
+        /**
+         * @brief Searches the index for a player by name.
+         * @param playerName The name to look for.
+         * @return The player's index position, or std::nullopt if the file does not hold them.
+         * @note O(log P); only the names of the probed records are touched.
+         */
+        std::optional<size_t> find(std::string_view playerName) const;
+
+        /**
+         * @brief Views the record of an index entry in place.
+         * @param slot An index position in [0, getSize()).
+         * @return A RecordView over the mapped bytes, valid for the roster's lifetime.
+         * @throws std::out_of_range If `slot` is not in the index.
+         * @throws std::invalid_argument If the record is malformed.
+         */
+        PlayerCodec::RecordView getRecord(size_t slot) const;
+
+        /**
+         * @brief Writes every player of a guild to a roster file.
+         * @param guild A const ref. to the Guild to save. Materialized players are encoded;
+         *  cold players and those still only in the guild's attached roster are copied over byte for byte.
+         * @param path The file to create or replace. It is written to `path + ".tmp"`
+         *  first and renamed over `path`, so readers never see a partial file.
+         *  The file and its directory are flushed to disk before `write` returns.
+         * @throws std::system_error If the file cannot be written.
+         */
+        static void write(const Guild& guild, const std::string& path);
+};
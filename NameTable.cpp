@@ -0,0 +1,81 @@
+#include "NameTable.hpp"
+#include <mutex>     // For std::unique_lock
+#include <stdexcept> // For std::out_of_range
+
+/**
+ * @brief Constructs an empty NameTable.
+ * @post The empty name "" is interned as handle 0, so default-constructed
+ *  Items always pack to the same handle.
+ */
+NameTable::NameTable() {
+    intern("");
+}
+
+/**
+ * @brief Retrieves the process-wide NameTable.
+ * @return A reference to the shared table used when no per-shard table is given.
+ */
+NameTable& NameTable::global() {
+    static NameTable table;
+    return table;
+}
+
+/**
+ * @brief Retrieves the handle for a name, interning it if it is new.
+ * @param name A const ref. to the name to intern.
+ * @return The 32-bit handle identifying `name` in this table.
+ */
+std::uint32_t NameTable::intern(const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto found = handles_.find(name);
+        if (found != handles_.end()) { return found->second; }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Another writer may have interned the name between the two locks
+    auto inserted = handles_.emplace(name, static_cast<std::uint32_t>(names_.size()));
+    if (inserted.second) { names_.push_back(name); }
+    return inserted.first->second;
+}
+
+/**
+ * @brief Retrieves the name behind a handle.
+ * @param handle A handle previously returned by `intern`.
+ * @return A const ref. to the interned name. It stays valid for the table's lifetime.
+ * @throws std::out_of_range If `handle` was not issued by this table.
+ */
+const std::string& NameTable::getName(std::uint32_t handle) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (handle >= names_.size()) {
+        throw std::out_of_range("Invalid item name handle.");
+    }
+    return names_[handle];
+}
+
+/**
+ * @brief Retrieves the number of interned names.
+ * @return The number of distinct names in the table, including "".
+ */
+size_t NameTable::getSize() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+/**
+ * @brief Converts an Item to its packed form.
+ * @param item A const ref. to the Item to pack.
+ * @return A PackedItem holding the interned handle of `item.name_`.
+ */
+PackedItem NameTable::pack(const Item& item) {
+    return PackedItem{intern(item.name_), item.weight_, item.type_};
+}
+
+/**
+ * @brief Converts a PackedItem back to an Item.
+ * @param packed A const ref. to a PackedItem created by this table.
+ * @return An Item with the name behind `packed.name_id_`.
+ * @throws std::out_of_range If the handle was not issued by this table.
+ */
+Item NameTable::unpack(const PackedItem& packed) const {
+    return Item{getName(packed.name_id_), packed.weight_, packed.type_};
+}
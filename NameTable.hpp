@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include "Item.hpp"
+
+class NameTable {
+    private:
+        /** Every interned name, indexed by handle.
+        * A deque never relocates its elements on growth, so references
+        * handed out by `getName` stay valid while other names are added.
+        */
+        std::deque<std::string> names_;
+
+        // Maps each interned name to its handle
+        std::unordered_map<std::string, std::uint32_t> handles_;
+
+        // Guards `names_` and `handles_`; lookups share it, new names take it exclusively
+        mutable std::shared_mutex mutex_;
+    public:
+        /**
+         * @brief Constructs an empty NameTable.
+         * @post The empty name "" is interned as handle 0, so default-constructed
+         *  Items always pack to the same handle.
+         */
+        NameTable();
+
+        /**
+         * @brief Retrieves the process-wide NameTable.
+         * @return A reference to the shared table used when no per-shard table is given.
+         */
+        static NameTable& global();
+
+        /**
+         * @brief Retrieves the handle for a name, interning it if it is new.
+         * @param name A const ref. to the name to intern.
+         * @return The 32-bit handle identifying `name` in this table.
+         */
+        std::uint32_t intern(const std::string& name);
+
+        /**
+         * @brief Retrieves the name behind a handle.
+         * @param handle A handle previously returned by `intern`.
+         * @return A const ref. to the interned name. It stays valid for the table's lifetime.
+         * @throws std::out_of_range If `handle` was not issued by this table.
+         */
+        const std::string& getName(std::uint32_t handle) const;
+
+        /**
+         * @brief Retrieves the number of interned names.
+         * @return The number of distinct names in the table, including "".
+         */
+        size_t getSize() const;
+
+        /**
+         * @brief Converts an Item to its packed form.
+         * @param item A const ref. to the Item to pack.
+         * @return A PackedItem holding the interned handle of `item.name_`.
+         */
+        PackedItem pack(const Item& item);
+
+        /**
+         * @brief Converts a PackedItem back to an Item.
+         * @param packed A const ref. to a PackedItem created by this table.
+         * @return An Item with the name behind `packed.name_id_`.
+         * @throws std::out_of_range If the handle was not issued by this table.
+         */
+        Item unpack(const PackedItem& packed) const;
+};
@@ -7,7 +7,15 @@
 *      If none provided, default value of a default constructed Inventory
 */
 Player::Player(const std::string& name, const Inventory& inventory)
-        : name_(name), inventory_(inventory) {}
+        : inventory_(inventory), name_(name) {}
+
+/**
+* @brief Constructs a Player that takes over an existing Inventory.
+* @param name A string to be the player name. Pass an r-value to avoid copying it.
+* @param inventory An r-value ref. to the Inventory to move into the Player's inventory_ member
+*/
+Player::Player(std::string name, Inventory&& inventory)
+        : inventory_(std::move(inventory)), name_(std::move(name)) {}
 
 /**
 * @brief Gets the name of the Player.
@@ -17,6 +25,14 @@ std::string Player::getName() const {
     return name_;
 }
 
+/**
+* @brief Exposes the name of the Player without copying it
+* @return A string_view of the name, valid until the Player is modified or destroyed
+*/
+std::string_view Player::getNameView() const {
+    return name_;
+}
+
 /**
 * @brief Exposes a reference to interact with the Player's Inventory.
 * @return An reference to the Player's Inventory.
@@ -27,12 +43,37 @@ Inventory& Player::getInventoryRef() {
     return inventory_;
 }
 
+/**
+* @brief Exposes a read-only reference to the Player's Inventory.
+* @return A const reference to the Player's Inventory.
+*/
+const Inventory& Player::getInventoryRef() const {
+    return inventory_;
+}
+
+/**
+* @brief Retrieves the allocator of the Player's Inventory
+* @return The allocator for the memory resource backing the inventory
+*/
+Player::allocator_type Player::get_allocator() const {
+    return inventory_.get_allocator();
+}
+
 /**
 * @brief Copy constructor for the Player class.
 * @param rhs A const l-value ref. to the Player object to copy.
 * @post Creates a deep copy of `rhs`
 */
-Player::Player(const Player& rhs) : name_(rhs.name_), inventory_(rhs.inventory_) {}
+Player::Player(const Player& rhs) : CountedInstance(rhs), inventory_(rhs.inventory_), name_(rhs.name_) {}
+
+/**
+* @brief Allocator-extended copy constructor for the Player class.
+* @param rhs A const l-value ref. to the Player object to copy.
+* @param alloc The allocator whose memory resource backs the copy's Inventory.
+* @post Creates a deep copy of `rhs`, as Inventory's allocator-extended copy does.
+*/
+Player::Player(const Player& rhs, const allocator_type& alloc)
+        : CountedInstance(rhs), inventory_(rhs.inventory_, alloc), name_(rhs.name_) {}
 
 /**
 * @brief Move constructor for the Player class.
@@ -40,7 +81,18 @@ Player::Player(const Player& rhs) : name_(rhs.name_), inventory_(rhs.inventory_)
 * @post Transfers ownership of resources from `rhs`
 * to the newly constructed Player object *using move semantics*
 */
-Player::Player(Player&& rhs) : name_(std::move(rhs.name_)), inventory_(std::move(rhs.inventory_)) {}
+Player::Player(Player&& rhs) noexcept
+        : CountedInstance(std::move(rhs)), inventory_(std::move(rhs.inventory_)), name_(std::move(rhs.name_)) {}
+
+/**
+* @brief Allocator-extended move constructor for the Player class.
+* @param rhs An r-value ref. to a Player object to move from.
+* @param alloc The allocator whose memory resource backs the new Player's Inventory.
+* @post As the move constructor if `rhs` uses the same memory resource;
+*  otherwise the inventory is re-allocated from `alloc`.
+*/
+Player::Player(Player&& rhs, const allocator_type& alloc)
+        : CountedInstance(std::move(rhs)), inventory_(std::move(rhs.inventory_), alloc), name_(std::move(rhs.name_)) {}
 
 /**
 * @brief Copy assignment operator for the Player class.
@@ -48,11 +100,13 @@ Player::Player(Player&& rhs) : name_(std::move(rhs.name_)), inventory_(std::move
 * @return A reference to the updated Player object.
 * @post Performs a deep copy of `rhs`, including
 * re-allocating and copying the Inventory and ID.
+* If the copy throws, this object is left unchanged.
 */
 Player& Player::operator=(const Player& rhs) {
+    Instrumentation::record(Instrumentation::PLAYER_COPY_ASSIGNED);
     if (this != &rhs) { // Self-assignment check
-        name_ = rhs.name_;
-        inventory_ = rhs.inventory_; // Deep copy
+        Player copy(rhs, get_allocator()); // Deep copy on our memory resource; may throw before anything is modified
+        *this = std::move(copy); // Cannot throw
     }
     return *this;
 }
@@ -62,12 +116,15 @@ Player& Player::operator=(const Player& rhs) {
 * @param rhs An r-value ref. to a Player object to move from.
 * @return A reference to the updated Player object.
 * @post Transfers ownership of member resources from `rhs`
-* to the updated Player object *using move semantics*
+* to the updated Player object *using move semantics*.
+* The Inventory keeps this Player's memory resource, as Inventory's move assignment does,
+* so moving in a Player on an unequal resource copies the inventory and may throw.
 */
 Player& Player::operator=(Player&& rhs) {
+    Instrumentation::record(Instrumentation::PLAYER_MOVE_ASSIGNED);
     if (this != &rhs) { // Self-assignment check
+        inventory_ = std::move(rhs.inventory_); // First, since only it can throw
         name_ = std::move(rhs.name_);
-        inventory_ = std::move(rhs.inventory_);
     }
     return *this;
 }
@@ -1,13 +1,18 @@
 #pragma once
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include "Inventory.hpp"
 
-class Player {
+class Player : CountedInstance<Instrumentation::PLAYER_CONSTRUCTED> {
     private:
         Inventory inventory_;
         std::string name_;
 
     public:
+        // Lets std::pmr containers, like Guild's roster, allocate each Player's inventory from their resource
+        using allocator_type = Inventory::allocator_type;
+
         /**
          * @brief Constructs a Player with the given identifier.
          * @param name A const. string reference to be the player name
@@ -15,6 +20,13 @@ class Player {
          *      If none provided, default value of a default constructed Inventory
          */
         Player(const std::string& name, const Inventory& inventory = Inventory());
+
+        /**
+         * @brief Constructs a Player that takes over an existing Inventory.
+         * @param name A string to be the player name. Pass an r-value to avoid copying it.
+         * @param inventory An r-value ref. to the Inventory to move into the Player's inventory_ member
+         */
+        Player(std::string name, Inventory&& inventory);
         
         /**
          * @brief Gets the name of the Player
@@ -22,6 +34,12 @@ class Player {
          */
         std::string getName() const;
 
+        /**
+         * @brief Exposes the name of the Player without copying it
+         * @return A string_view of the name, valid until the Player is modified or destroyed
+         */
+        std::string_view getNameView() const;
+
         /**
          * @brief Exposes a reference to interact with the Player's Inventory.
          * @return An reference to the Player's Inventory.
@@ -29,6 +47,18 @@ class Player {
          *  is NOT declared const.
          */
         Inventory& getInventoryRef();
+
+        /**
+         * @brief Exposes a read-only reference to the Player's Inventory.
+         * @return A const reference to the Player's Inventory.
+         */
+        const Inventory& getInventoryRef() const;
+
+        /**
+         * @brief Retrieves the allocator of the Player's Inventory
+         * @return The allocator for the memory resource backing the inventory
+         */
+        allocator_type get_allocator() const;
         
        /**
          * @brief Copy constructor for the Player class.
@@ -36,6 +66,14 @@ class Player {
          * @post Creates a deep copy of `rhs`
          */
         Player(const Player& rhs);
+
+        /**
+         * @brief Allocator-extended copy constructor for the Player class.
+         * @param rhs A const l-value ref. to the Player object to copy.
+         * @param alloc The allocator whose memory resource backs the copy's Inventory.
+         * @post Creates a deep copy of `rhs`, as Inventory's allocator-extended copy does.
+         */
+        Player(const Player& rhs, const allocator_type& alloc);
         
          /**
          * @brief Move constructor for the Player class.
@@ -43,7 +81,16 @@ class Player {
          * @post Transfers ownership of resources from `rhs`
          * to the newly constructed Player object *using move semantics*
          */
-        Player(Player&& rhs);
+        Player(Player&& rhs) noexcept;
+
+        /**
+         * @brief Allocator-extended move constructor for the Player class.
+         * @param rhs An r-value ref. to a Player object to move from.
+         * @param alloc The allocator whose memory resource backs the new Player's Inventory.
+         * @post As the move constructor if `rhs` uses the same memory resource;
+         *  otherwise the inventory is re-allocated from `alloc`.
+         */
+        Player(Player&& rhs, const allocator_type& alloc);
 
         /**
          * @brief Copy assignment operator for the Player class.
@@ -51,6 +98,7 @@ class Player {
          * @return A reference to the updated Player object.
          * @post Performs a deep copy of `rhs`, including 
          * re-allocating and copying the Inventory and ID.
+         * If the copy throws, this object is left unchanged.
          */
         Player& operator=(const Player& rhs);
 
@@ -59,7 +107,9 @@ class Player {
          * @param rhs An r-value ref. to a Player object to move from.
          * @return A reference to the updated Player object.
          * @post Transfers ownership of member resources from `rhs` 
-         * to the updated Player object *using move semantics*
+         * to the updated Player object *using move semantics*.
+         * The Inventory keeps this Player's memory resource, as Inventory's move assignment does,
+         * so moving in a Player on an unequal resource copies the inventory and may throw.
          */
         Player& operator=(Player&& rhs);
         
@@ -70,4 +120,7 @@ class Player {
          *   we rely on the default destructor
          */
         ~Player() = default;
-};
\ No newline at end of file
+};
+
+// Lets the roster vector in Guild relocate players by move when it grows
+static_assert(std::is_nothrow_move_constructible<Player>::value, "Player must be nothrow movable");
\ No newline at end of file
@@ -0,0 +1,696 @@
+#include "PlayerCodec.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+static constexpr std::uint8_t MAGIC[4] = {'M', 'P', 'L', 'R'};
+
+// Tags of the equipped section
+static constexpr std::uint8_t EQUIPPED_NONE = 0;      // No item is equipped
+static constexpr std::uint8_t EQUIPPED_ITEM = 1;      // A name id, weight and type follow
+static constexpr std::uint8_t EQUIPPED_UNCHANGED = 2; // DELTA only: keep the base's equipped item
+
+/**
+* @brief Appends little-endian fields to a byte buffer.
+*/
+struct ByteWriter {
+    std::vector<std::uint8_t>& out_;
+
+    void u8(std::uint8_t value) { out_.push_back(value); }
+
+    void u16(std::uint16_t value) {
+        out_.push_back(static_cast<std::uint8_t>(value));
+        out_.push_back(static_cast<std::uint8_t>(value >> 8));
+    }
+
+    void u32(std::uint32_t value) {
+        for (unsigned shift = 0; shift < 32; shift += 8) { out_.push_back(static_cast<std::uint8_t>(value >> shift)); }
+    }
+
+    void f32(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+
+    // Writes the low `width` bytes of a name id
+    void id(std::uint32_t value, std::uint8_t width) {
+        for (unsigned shift = 0; shift < width * 8u; shift += 8) { out_.push_back(static_cast<std::uint8_t>(value >> shift)); }
+    }
+
+    void bytes(std::string_view text) { out_.insert(out_.end(), text.begin(), text.end()); }
+};
+
+/**
+* @brief Reads little-endian fields from a bounded byte range.
+* Every read is bounds checked, so truncated input throws instead of over-reading.
+*/
+struct ByteReader {
+    const std::uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+
+    // Returns a pointer to the next `count` bytes and skips past them
+    const std::uint8_t* take(size_t count) {
+        if (count > size_ - pos_) { throw std::invalid_argument("Truncated player record."); }
+        const std::uint8_t* start = data_ + pos_;
+        pos_ += count;
+        return start;
+    }
+
+    std::uint8_t u8() { return *take(1); }
+
+    std::uint16_t u16() {
+        const std::uint8_t* p = take(2);
+        return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    std::uint32_t u32() { return load32(take(4)); }
+
+    float f32() { return loadFloat(take(4)); }
+
+    std::uint32_t id(std::uint8_t width) { return loadId(take(width), width); }
+
+    static std::uint32_t load32(const std::uint8_t* p) {
+        return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8)
+             | (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+
+    static float loadFloat(const std::uint8_t* p) {
+        std::uint32_t bits = load32(p);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static std::uint32_t loadId(const std::uint8_t* p, std::uint8_t width) {
+        std::uint32_t value = 0;
+        for (unsigned byte = 0; byte < width; byte++) { value |= static_cast<std::uint32_t>(p[byte]) << (byte * 8); }
+        return value;
+    }
+};
+
+/**
+* @brief The names referenced by one record, in first-use order.
+* Keys view the caller's strings, so the table must not outlive the encoded Player.
+*/
+struct RecordNames {
+    std::vector<std::string_view> names_{std::string_view()};
+    std::unordered_map<std::string_view, std::uint32_t> ids_{{std::string_view(), 0}};
+
+    std::uint32_t intern(const std::string& name) {
+        auto [entry, inserted] = ids_.try_emplace(name, static_cast<std::uint32_t>(names_.size()));
+        if (inserted) { names_.push_back(name); }
+        return entry->second;
+    }
+
+    // The narrowest id width able to address every entry
+    std::uint8_t idWidth() const {
+        if (names_.size() <= 0x100) { return 1; }
+        if (names_.size() <= 0x10000) { return 2; }
+        return 4;
+    }
+};
+
+/**
+* @brief The fixed header shared by every record kind.
+*/
+struct RecordHeader {
+    std::uint8_t kind;
+    std::uint8_t id_width;
+    std::uint32_t rows;
+    std::uint32_t cols;
+    std::uint32_t item_count;
+    float weight;
+    std::uint32_t name_count;
+    std::string_view player_name; // Views the record's bytes
+};
+
+/**
+* @brief The name table of a record, left in place.
+*/
+struct NameSection {
+    const std::uint8_t* ends;  // The u32 end offset of every entry
+    std::uint32_t count;       // The number of entries
+    const char* bytes;         // The concatenated entry bytes
+    std::uint32_t bytes_size;  // The length of `bytes`, which is the last end offset
+
+    // Slices entry `id`, validating its offsets
+    std::string_view get(std::uint32_t id) const {
+        if (id >= count) { throw std::invalid_argument("Invalid name id in player record."); }
+        std::uint32_t start = id ? ByteReader::load32(ends + (id - 1) * 4) : 0;
+        std::uint32_t end = ByteReader::load32(ends + id * 4);
+        if (end < start || end > bytes_size) { throw std::invalid_argument("Corrupt player record name table."); }
+        return std::string_view(bytes + start, end - start);
+    }
+};
+
+/**
+* @brief Writes the fixed header and the name table of a record.
+* @throws std::invalid_argument If a dimension or name does not fit its 32-bit field,
+*  or only one of the dimensions is zero.
+*/
+static void writePrologue(ByteWriter& out, std::uint8_t kind, const Player& player,
+                          const RecordNames& names, std::uint8_t width) {
+    constexpr size_t LIMIT = std::numeric_limits<std::uint32_t>::max();
+    const Inventory& inventory = player.getInventoryRef();
+    if (inventory.getRows() > LIMIT || inventory.getCols() > LIMIT || player.getName().size() > LIMIT) {
+        throw std::invalid_argument("Player is too large to encode.");
+    }
+    if ((inventory.getRows() == 0) != (inventory.getCols() == 0)) {
+        throw std::invalid_argument("Cannot encode an inventory with only one zero dimension.");
+    }
+
+    out.bytes(std::string_view(reinterpret_cast<const char*>(MAGIC), sizeof(MAGIC)));
+    out.u16(PlayerCodec::FORMAT_VERSION);
+    out.u8(kind);
+    out.u8(width);
+    out.u32(static_cast<std::uint32_t>(inventory.getRows()));
+    out.u32(static_cast<std::uint32_t>(inventory.getCols()));
+    out.u32(static_cast<std::uint32_t>(inventory.getCount()));
+    out.f32(inventory.getWeight());
+    out.u32(static_cast<std::uint32_t>(names.names_.size()));
+    out.u32(static_cast<std::uint32_t>(player.getName().size()));
+    out.bytes(player.getName());
+
+    // End offsets first, so a reader can slice any entry without walking the others
+    size_t end = 0;
+    for (std::string_view name : names.names_) {
+        end += name.size();
+        if (end > LIMIT) { throw std::invalid_argument("Player is too large to encode."); }
+        out.u32(static_cast<std::uint32_t>(end));
+    }
+    for (std::string_view name : names.names_) { out.bytes(name); }
+}
+
+/**
+* @brief Writes one item as a name id, weight and type.
+*/
+static void writeItem(ByteWriter& out, const Item& item, std::uint32_t nameId, std::uint8_t width) {
+    out.id(nameId, width);
+    out.f32(item.weight_);
+    out.u8(static_cast<std::uint8_t>(item.type_));
+}
+
+/**
+* @brief Reads the fixed header of a record.
+* @throws std::invalid_argument If the magic, version or id width is not recognised,
+*  only one of the dimensions is zero, or the item count exceeds the cells.
+*/
+static RecordHeader readHeader(ByteReader& in) {
+    if (std::memcmp(in.take(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::invalid_argument("Not a player record.");
+    }
+    if (in.u16() != PlayerCodec::FORMAT_VERSION) {
+        throw std::invalid_argument("Unsupported player record version.");
+    }
+    RecordHeader header;
+    header.kind = in.u8();
+    header.id_width = in.u8();
+    if (header.id_width != 1 && header.id_width != 2 && header.id_width != 4) {
+        throw std::invalid_argument("Invalid player record name id width.");
+    }
+    header.rows = in.u32();
+    header.cols = in.u32();
+    header.item_count = in.u32();
+    // With one zero dimension the grid has no cells whatever the other says, so the size checks cannot bound it
+    if ((header.rows == 0) != (header.cols == 0)
+        || header.item_count > static_cast<std::uint64_t>(header.rows) * header.cols) {
+        throw std::invalid_argument("Invalid player record dimensions.");
+    }
+    header.weight = in.f32();
+    header.name_count = in.u32();
+    std::uint32_t nameLength = in.u32();
+    header.player_name = std::string_view(reinterpret_cast<const char*>(in.take(nameLength)), nameLength);
+    return header;
+}
+
+/**
+* @brief Locates the name table of a record without copying any entry.
+* @throws std::invalid_argument If the table is empty or truncated.
+*/
+static NameSection sliceNames(ByteReader& in, std::uint32_t count) {
+    if (count == 0) { throw std::invalid_argument("Player record has no name table."); }
+    NameSection section;
+    section.ends = in.take(static_cast<size_t>(count) * 4);
+    section.count = count;
+    section.bytes_size = ByteReader::load32(section.ends + (count - 1) * 4);
+    section.bytes = reinterpret_cast<const char*>(in.take(section.bytes_size));
+    return section;
+}
+
+/**
+* @brief Reads the name table of a record.
+* @throws std::invalid_argument If the table is truncated or its offsets are not ascending.
+*/
+static std::vector<std::string> readNames(ByteReader& in, std::uint32_t count) {
+    NameSection section = sliceNames(in, count);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (std::uint32_t entry = 0; entry < count; entry++) { names.emplace_back(section.get(entry)); }
+    return names;
+}
+
+/**
+* @brief Validates a stored ItemType byte.
+*/
+static ItemType toItemType(std::uint8_t type) {
+    if (type > ARMOR) { throw std::invalid_argument("Invalid item type in player record."); }
+    return static_cast<ItemType>(type);
+}
+
+/**
+* @brief Reads one item as a name id, weight and type, resolving the id against `names`.
+*/
+static void readItem(ByteReader& in, const std::vector<std::string>& names, std::uint8_t width, Item& item) {
+    std::uint32_t nameId = in.id(width);
+    if (nameId >= names.size()) { throw std::invalid_argument("Invalid name id in player record."); }
+    item.name_ = names[nameId];
+    item.weight_ = in.f32();
+    item.type_ = toItemType(in.u8());
+}
+
+/**
+* @brief Reads the equipped section of a record.
+* @param base The equipped item kept when the tag is EQUIPPED_UNCHANGED, or nullptr for a SNAPSHOT.
+* @return An owning pointer to the equipped item, or nullptr if nothing is equipped.
+*/
+static std::unique_ptr<Item> readEquipped(ByteReader& in, const std::vector<std::string>& names,
+                                          std::uint8_t width, const Item* const* base) {
+    std::uint8_t tag = in.u8();
+    if (tag == EQUIPPED_NONE) { return nullptr; }
+    if (tag == EQUIPPED_ITEM) {
+        auto equipped = std::make_unique<Item>();
+        readItem(in, names, width, *equipped);
+        return equipped;
+    }
+    if (tag == EQUIPPED_UNCHANGED && base) {
+        return (*base) ? std::make_unique<Item>(**base) : nullptr;
+    }
+    throw std::invalid_argument("Invalid equipped tag in player record.");
+}
+
+/**
+* @brief Wraps decoded cells in a Player and checks them against the header totals.
+*/
+static Player finishPlayer(const RecordHeader& header, std::vector<Item>&& cells, std::unique_ptr<Item> equipped) {
+    Inventory inventory(header.rows, header.cols, std::move(cells), equipped.release());
+    if (inventory.getCount() != header.item_count) {
+        throw std::invalid_argument("Player record totals do not match its cells.");
+    }
+    return Player(std::string(header.player_name), std::move(inventory));
+}
+
+/**
+* @brief Writes a DELTA record carrying the given cells and, if it changed, the equipped item.
+* @param current The Player whose current cells and equipped item are written.
+* @param changed The offsets of the cells to write, in ascending order.
+* @param equippedChanged True if the equipped item differs from the base snapshot.
+*/
+static std::vector<std::uint8_t> writeDelta(const Player& current, const std::vector<std::uint32_t>& changed,
+                                            bool equippedChanged) {
+    const Inventory& inventory = current.getInventoryRef();
+    RowView cells = inventory.view().cells();
+    RecordNames names;
+    std::vector<std::uint32_t> nameIds;
+    nameIds.reserve(changed.size());
+    for (std::uint32_t index : changed) { nameIds.push_back(names.intern(cells[index].name_)); }
+
+    const Item* equipped = inventory.getEquipped();
+    std::uint8_t equippedTag = EQUIPPED_UNCHANGED;
+    std::uint32_t equippedId = 0;
+    if (equippedChanged) {
+        equippedTag = equipped ? EQUIPPED_ITEM : EQUIPPED_NONE;
+        if (equipped) { equippedId = names.intern(equipped->name_); }
+    }
+    std::uint8_t width = names.idWidth();
+
+    std::vector<std::uint8_t> bytes;
+    bytes.reserve(64 + current.getName().size() + names.names_.size() * 16 + changed.size() * (9 + width));
+    ByteWriter out{bytes};
+    writePrologue(out, PlayerCodec::DELTA, current, names, width);
+
+    out.u8(equippedTag);
+    if (equippedTag == EQUIPPED_ITEM) { writeItem(out, *equipped, equippedId, width); }
+
+    out.u32(static_cast<std::uint32_t>(changed.size()));
+    for (size_t entry = 0; entry < changed.size(); entry++) {
+        out.u32(changed[entry]);
+        writeItem(out, cells[changed[entry]], nameIds[entry], width);
+    }
+    return bytes;
+}
+
+/**
+* @brief Encodes a full snapshot of a Player.
+* @param player A const ref. to the Player to encode.
+* @return The bytes of a SNAPSHOT record holding the player's name, grid and equipped item.
+*/
+std::vector<std::uint8_t> PlayerCodec::encode(const Player& player) {
+    std::vector<std::uint8_t> bytes;
+    encode(player, bytes);
+    return bytes;
+}
+
+/**
+* @brief Appends a full snapshot of a Player to an existing buffer.
+* @param player A const ref. to the Player to encode.
+* @param bytes The buffer the SNAPSHOT record is appended to, e.g. to batch many records.
+*/
+void PlayerCodec::encode(const Player& player, std::vector<std::uint8_t>& bytes) {
+    const Inventory& inventory = player.getInventoryRef();
+    RowView cells = inventory.view().cells();
+
+    // Intern straight from the grid's storage; no Item is copied
+    RecordNames names;
+    std::vector<std::uint32_t> nameIds(cells.size());
+    for (size_t index = 0; index < cells.size(); index++) { nameIds[index] = names.intern(cells[index].name_); }
+    const Item* equipped = inventory.getEquipped();
+    std::uint32_t equippedId = equipped ? names.intern(equipped->name_) : 0;
+    std::uint8_t width = names.idWidth();
+
+    // Grow geometrically, so appending many records to one buffer stays amortized O(1) per byte
+    size_t needed = bytes.size() + 64 + player.getName().size() + names.names_.size() * 16 + cells.size() * (5 + width);
+    if (needed > bytes.capacity()) { bytes.reserve(std::max(needed, bytes.capacity() * 2)); }
+    ByteWriter out{bytes};
+    writePrologue(out, SNAPSHOT, player, names, width);
+
+    if (equipped) {
+        out.u8(EQUIPPED_ITEM);
+        writeItem(out, *equipped, equippedId, width);
+    } else {
+        out.u8(EQUIPPED_NONE);
+    }
+
+    // Packed columns: weights, then types, then name ids
+    for (const Item& item : cells) { out.f32(item.weight_); }
+    for (const Item& item : cells) { out.u8(static_cast<std::uint8_t>(item.type_)); }
+    for (std::uint32_t nameId : nameIds) { out.id(nameId, width); }
+}
+
+/**
+* @brief Decodes a SNAPSHOT record into a new Player.
+* @param data A pointer to the first byte of the record.
+* @param size The number of bytes available at `data`.
+* @return A Player whose grid is built directly from the packed columns.
+* @throws std::invalid_argument If the bytes are not a well-formed SNAPSHOT record.
+*/
+Player PlayerCodec::decode(const std::uint8_t* data, size_t size) {
+    ByteReader in{data, size, 0};
+    RecordHeader header = readHeader(in);
+    if (header.kind != SNAPSHOT) { throw std::invalid_argument("Expected a player snapshot record."); }
+    std::vector<std::string> names = readNames(in, header.name_count);
+    std::unique_ptr<Item> equipped = readEquipped(in, names, header.id_width, nullptr);
+
+    // Slice all three columns up front, so a bogus size fails before anything is allocated
+    size_t count = static_cast<size_t>(header.rows) * header.cols;
+    if (count > (size - in.pos_) / (5 + header.id_width)) { throw std::invalid_argument("Truncated player record."); }
+    const std::uint8_t* weights = in.take(count * 4);
+    const std::uint8_t* types = in.take(count);
+    const std::uint8_t* nameIds = in.take(count * header.id_width);
+
+    // Fill the flat grid in place; it is handed to the Inventory without another copy
+    std::vector<Item> cells(count);
+    for (size_t index = 0; index < count; index++) {
+        std::uint32_t nameId = ByteReader::loadId(nameIds + index * header.id_width, header.id_width);
+        if (nameId >= names.size()) { throw std::invalid_argument("Invalid name id in player record."); }
+        cells[index].name_ = names[nameId];
+        cells[index].weight_ = ByteReader::loadFloat(weights + index * 4);
+        cells[index].type_ = toItemType(types[index]);
+    }
+    return finishPlayer(header, std::move(cells), std::move(equipped));
+}
+
+/**
+* @brief Decodes a SNAPSHOT record into a new Player.
+* @param bytes A const ref. to the bytes of the record.
+* @return A Player whose grid is built directly from the packed columns.
+* @throws std::invalid_argument If the bytes are not a well-formed SNAPSHOT record.
+*/
+Player PlayerCodec::decode(const std::vector<std::uint8_t>& bytes) {
+    return decode(bytes.data(), bytes.size());
+}
+
+/**
+* @brief Encodes the changes that turn one Player snapshot into another.
+* @param previous A const ref. to the Player the receiver already holds.
+* @param current A const ref. to the Player to transmit.
+* @return The bytes of a DELTA record listing only the changed cells.
+*  If the grid dimensions differ, a full SNAPSHOT record is returned instead.
+*/
+std::vector<std::uint8_t> PlayerCodec::encodeDelta(const Player& previous, const Player& current) {
+    const Inventory& before = previous.getInventoryRef();
+    const Inventory& after = current.getInventoryRef();
+    if (before.getRows() != after.getRows() || before.getCols() != after.getCols()
+            || after.getRows() * after.getCols() > std::numeric_limits<std::uint32_t>::max()) {
+        return encode(current);
+    }
+
+    RowView oldCells = before.view().cells();
+    RowView newCells = after.view().cells();
+    std::vector<std::uint32_t> changed;
+    for (size_t index = 0; index < newCells.size(); index++) {
+        if (!(oldCells[index] == newCells[index])) { changed.push_back(static_cast<std::uint32_t>(index)); }
+    }
+
+    const Item* oldEquipped = before.getEquipped();
+    const Item* newEquipped = after.getEquipped();
+    bool equippedChanged = oldEquipped ? (!newEquipped || !(*oldEquipped == *newEquipped)) : newEquipped != nullptr;
+    return writeDelta(current, changed, equippedChanged);
+}
+
+/**
+* @brief Encodes the changes an Inventory tracked since its last checkpoint.
+* @param current A const ref. to the Player to transmit.
+* @param changes The result of `current.getInventoryRef().drainChanges()`.
+* @return The bytes of a DELTA record listing only the cells in `changes`,
+*  to be applied to the snapshot the receiver held at that checkpoint.
+* @note O(changes): unlike the two-snapshot overload, no grid is compared.
+*/
+std::vector<std::uint8_t> PlayerCodec::encodeDelta(const Player& current, const InventoryChanges& changes) {
+    const Inventory& inventory = current.getInventoryRef();
+    if (inventory.getRows() * inventory.getCols() > std::numeric_limits<std::uint32_t>::max()) {
+        return encode(current);
+    }
+    std::vector<std::uint32_t> changed;
+    changed.reserve(changes.cells.size());
+    for (const auto& cell : changes.cells) {
+        changed.push_back(static_cast<std::uint32_t>(cell.first * inventory.getCols() + cell.second));
+    }
+    return writeDelta(current, changed, changes.equipped);
+}
+
+/**
+* @brief Applies a record produced by `encodeDelta` to a base Player.
+* @param previous A const ref. to the Player the delta was encoded against.
+* @param data A pointer to the first byte of the record.
+* @param size The number of bytes available at `data`.
+* @return The Player described by the record. A SNAPSHOT record ignores `previous`.
+* @throws std::invalid_argument If the record is malformed or does not match the
+*  dimensions of `previous`.
+*/
+Player PlayerCodec::applyDelta(const Player& previous, const std::uint8_t* data, size_t size) {
+    ByteReader in{data, size, 0};
+    RecordHeader header = readHeader(in);
+    if (header.kind == SNAPSHOT) { return decode(data, size); }
+    if (header.kind != DELTA) { throw std::invalid_argument("Unknown player record kind."); }
+
+    const Inventory& base = previous.getInventoryRef();
+    if (header.rows != base.getRows() || header.cols != base.getCols()) {
+        throw std::invalid_argument("Delta record does not match the base inventory's dimensions.");
+    }
+    std::vector<std::string> names = readNames(in, header.name_count);
+    const Item* baseEquipped = base.getEquipped();
+    std::unique_ptr<Item> equipped = readEquipped(in, names, header.id_width, &baseEquipped);
+
+    std::uint32_t changes = in.u32();
+    if (changes > (size - in.pos_) / (9 + header.id_width)) { throw std::invalid_argument("Truncated player record."); }
+
+    // One copy of the base grid, patched in place and handed to the new Inventory
+    RowView baseCells = base.view().cells();
+    std::vector<Item> cells(baseCells.begin(), baseCells.end());
+    for (std::uint32_t entry = 0; entry < changes; entry++) {
+        std::uint32_t index = in.u32();
+        if (index >= cells.size()) { throw std::invalid_argument("Invalid cell offset in player record."); }
+        readItem(in, names, header.id_width, cells[index]);
+    }
+    return finishPlayer(header, std::move(cells), std::move(equipped));
+}
+
+/**
+* @brief Applies a record produced by `encodeDelta` to a base Player.
+* @param previous A const ref. to the Player the delta was encoded against.
+* @param bytes A const ref. to the bytes of the record.
+* @return The Player described by the record. A SNAPSHOT record ignores `previous`.
+* @throws std::invalid_argument If the record is malformed or does not match the
+*  dimensions of `previous`.
+*/
+Player PlayerCodec::applyDelta(const Player& previous, const std::vector<std::uint8_t>& bytes) {
+    return applyDelta(previous, bytes.data(), bytes.size());
+}
+
+/**
+* @brief Locates the sections of a SNAPSHOT record in O(1).
+* @param data A pointer to the first byte of the record.
+* @param size The number of bytes available at `data`.
+* @throws std::invalid_argument If the bytes are not a SNAPSHOT record or
+*  its sections do not fit in `size` bytes.
+*/
+PlayerCodec::RecordView::RecordView(const std::uint8_t* data, size_t size) : data_(data), size_(size) {
+    ByteReader in{data, size, 0};
+    RecordHeader header = readHeader(in);
+    if (header.kind != SNAPSHOT) { throw std::invalid_argument("Expected a player snapshot record."); }
+    rows_ = header.rows;
+    cols_ = header.cols;
+    id_width_ = header.id_width;
+    name_ = header.player_name;
+
+    NameSection names = sliceNames(in, header.name_count);
+    name_ends_ = names.ends;
+    name_count_ = names.count;
+    name_bytes_ = names.bytes;
+    name_bytes_size_ = names.bytes_size;
+
+    std::uint8_t tag = in.u8();
+    if (tag != EQUIPPED_NONE && tag != EQUIPPED_ITEM) { throw std::invalid_argument("Invalid equipped tag in player record."); }
+    equipped_ = (tag == EQUIPPED_ITEM) ? in.take(id_width_ + 5) : nullptr;
+
+    size_t count = rows_ * cols_;
+    if (count > (size - in.pos_) / (5 + id_width_)) { throw std::invalid_argument("Truncated player record."); }
+    weights_ = in.take(count * 4);
+    types_ = in.take(count);
+    name_ids_ = in.take(count * id_width_);
+}
+
+/**
+* @brief Resolves a name id against the record's name table.
+* @throws std::invalid_argument If the id or its offsets are out of range.
+*/
+std::string_view PlayerCodec::RecordView::nameFor(std::uint32_t id) const {
+    return NameSection{name_ends_, name_count_, name_bytes_, name_bytes_size_}.get(id);
+}
+
+/**
+* @brief Builds an Item from a stored name id, weight and type.
+*/
+Item PlayerCodec::RecordView::itemAt(const std::uint8_t* nameId, const std::uint8_t* weight, std::uint8_t type) const {
+    return Item(std::string(nameFor(ByteReader::loadId(nameId, id_width_))), ByteReader::loadFloat(weight), toItemType(type));
+}
+
+/**
+* @brief Retrieves the player name stored in the record
+* @return A view of the name, valid as long as the record's bytes are
+*/
+std::string_view PlayerCodec::RecordView::getName() const {
+    return name_;
+}
+
+/**
+* @brief Retrieves the first byte of the viewed record
+* @return The value stored in `data_`, for copying the record without re-encoding it
+*/
+const std::uint8_t* PlayerCodec::RecordView::getData() const {
+    return data_;
+}
+
+/**
+* @brief Retrieves the length of the viewed record
+* @return The value stored in `size_`
+*/
+size_t PlayerCodec::RecordView::getSize() const {
+    return size_;
+}
+
+/**
+* @brief Retrieves the number of rows of the encoded grid
+* @return The grid's row count
+*/
+size_t PlayerCodec::RecordView::getRows() const {
+    return rows_;
+}
+
+/**
+* @brief Retrieves the number of columns of the encoded grid
+* @return The grid's column count
+*/
+size_t PlayerCodec::RecordView::getCols() const {
+    return cols_;
+}
+
+/**
+* @brief Sums the weights of the encoded grid's items from the weight column
+* @return The Inventory::getWeight() that decode() would give the Player. The header's
+*  total weight is not consulted, so a stale or corrupt header cannot skew it.
+* @note O(rows * cols): only the type and weight columns are read.
+* @throws std::invalid_argument If a cell holds an invalid item type.
+*/
+float PlayerCodec::RecordView::getWeight() const {
+    // Summed in row-major order like Inventory::adoptCells, so the result matches the decoded grid exactly
+    float weight = 0;
+    for (size_t index = 0; index < rows_ * cols_; index++) {
+        if (toItemType(types_[index]) != NONE) { weight += ByteReader::loadFloat(weights_ + index * 4); }
+    }
+    return weight;
+}
+
+/**
+* @brief Counts the encoded grid's items from the type column
+* @return The Inventory::getCount() that decode() would give the Player. decode() rejects
+*  a record whose header count differs from it.
+* @note O(rows * cols): only the type column is read.
+* @throws std::invalid_argument If a cell holds an invalid item type.
+*/
+size_t PlayerCodec::RecordView::getCount() const {
+    size_t count = 0;
+    for (size_t index = 0; index < rows_ * cols_; index++) {
+        if (toItemType(types_[index]) != NONE) { count++; }
+    }
+    return count;
+}
+
+/**
+* @brief Reads one cell of the encoded grid.
+* @param row The row index in the grid.
+* @param col The column index in the grid.
+* @return A copy of the cell's Item.
+* @throws std::out_of_range If the row or column is out of bounds.
+*/
+Item PlayerCodec::RecordView::at(size_t row, size_t col) const {
+    if (row >= rows_ || col >= cols_) { throw std::out_of_range("Invalid inventory index."); }
+    size_t index = row * cols_ + col;
+    return itemAt(name_ids_ + index * id_width_, weights_ + index * 4, types_[index]);
+}
+
+/**
+* @brief Reads the encoded equipped item.
+* @return A copy of the equipped Item, or std::nullopt if nothing was equipped.
+*/
+std::optional<Item> PlayerCodec::RecordView::getEquipped() const {
+    if (!equipped_) { return std::nullopt; }
+    return itemAt(equipped_, equipped_ + id_width_, equipped_[id_width_ + 4]);
+}
+
+/**
+* @brief Counts the cells of every ItemType by scanning the type column only.
+* @return An array indexed by ItemType holding the number of cells of each type.
+*/
+std::array<size_t, 4> PlayerCodec::RecordView::countAllTypes() const {
+    std::array<size_t, 4> counts{};
+    for (size_t index = 0; index < rows_ * cols_; index++) {
+        counts[toItemType(types_[index])]++;
+    }
+    return counts;
+}
+
+/**
+* @brief Decodes the whole record into a Player.
+* @return The Player, as PlayerCodec::decode would build it.
+*/
+Player PlayerCodec::RecordView::materialize() const {
+    return decode(data_, size_);
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "Inventory.hpp"
+#include "Player.hpp"
+
+/** Binary encoding of Player snapshots and of deltas between two snapshots.
+*
+* Every record is little-endian and starts with the same fixed header:
+*
+*     offset  size  field
+*          0     4  magic "MPLR"
+*          4     2  format version (FORMAT_VERSION)
+*          6     1  record kind (SNAPSHOT or DELTA)
+*          7     1  width in bytes of each cell name id (1, 2 or 4)
+*          8     4  grid rows
+*         12     4  grid columns
+*         16     4  number of non-NONE cells in the resulting grid
+*         20     4  total weight of the resulting grid (float)
+*         24     4  number of entries N in the name table
+*         28     4  length L of the player name
+*         32     L  player name bytes
+*
+* followed by the name table (N end offsets as u32, then the concatenated
+* name bytes; entry 0 is always ""), and the equipped section
+* (u8 tag, then u32 name id, f32 weight, u8 type when an item is present).
+*
+* A SNAPSHOT then stores its grid as three packed columns of rows * cols
+* entries each: f32 weights, u8 types and the name ids. The columns have fixed
+* widths, so any cell can be located without parsing the cells before it.
+* Readers recompute the header's item count and total weight from the columns:
+* decode() rejects a record whose count disagrees, and RecordView never reads either.
+*
+* A DELTA stores only the cells that differ from the base snapshot:
+* a u32 count, then per cell its u32 offset, f32 weight, u8 type and name id.
+* Its name table only lists names used by those cells and the equipped item.
+*/
+class PlayerCodec {
+    public:
+        class RecordView;
+
+        // The format version written into, and required from, every record
+        static constexpr std::uint16_t FORMAT_VERSION = 1;
+
+        // The record kinds stored at offset 6
+        static constexpr std::uint8_t SNAPSHOT = 1;
+        static constexpr std::uint8_t DELTA = 2;
+
+        /**
+         * @brief Encodes a full snapshot of a Player.
+         * @param player A const ref. to the Player to encode.
+         * @return The bytes of a SNAPSHOT record holding the player's name, grid and equipped item.
+         */
+        static std::vector<std::uint8_t> encode(const Player& player);
+
+        /**
+         * @brief Appends a full snapshot of a Player to an existing buffer.
+         * @param player A const ref. to the Player to encode.
+         * @param bytes The buffer the SNAPSHOT record is appended to, e.g. to batch many records.
+         */
+        static void encode(const Player& player, std::vector<std::uint8_t>& bytes);
+
+        /**
+         * @brief Decodes a SNAPSHOT record into a new Player.
+         * @param data A pointer to the first byte of the record.
+         * @param size The number of bytes available at `data`.
+         * @return A Player whose grid is built directly from the packed columns.
+         * @throws std::invalid_argument If the bytes are not a well-formed SNAPSHOT record.
+         */
+        static Player decode(const std::uint8_t* data, size_t size);
+
+        /**
+         * @brief Decodes a SNAPSHOT record into a new Player.
+         * @param bytes A const ref. to the bytes of the record.
+         * @return A Player whose grid is built directly from the packed columns.
+         * @throws std::invalid_argument If the bytes are not a well-formed SNAPSHOT record.
+         */
+        static Player decode(const std::vector<std::uint8_t>& bytes);
+
+        /**
+         * @brief Encodes the changes that turn one Player snapshot into another.
+         * @param previous A const ref. to the Player the receiver already holds.
+         * @param current A const ref. to the Player to transmit.
+         * @return The bytes of a DELTA record listing only the changed cells.
+         *  If the grid dimensions differ, a full SNAPSHOT record is returned instead.
+         */
+        static std::vector<std::uint8_t> encodeDelta(const Player& previous, const Player& current);
+
+        /**
+         * @brief Encodes the changes an Inventory tracked since its last checkpoint.
+         * @param current A const ref. to the Player to transmit.
+         * @param changes The result of `current.getInventoryRef().drainChanges()`.
+         * @return The bytes of a DELTA record listing only the cells in `changes`,
+         *  to be applied to the snapshot the receiver held at that checkpoint.
+         * @note O(changes): unlike the two-snapshot overload, no grid is compared.
+         */
+        static std::vector<std::uint8_t> encodeDelta(const Player& current, const InventoryChanges& changes);
+
+        /**
+         * @brief Applies a record produced by `encodeDelta` to a base Player.
+         * @param previous A const ref. to the Player the delta was encoded against.
+         * @param data A pointer to the first byte of the record.
+         * @param size The number of bytes available at `data`.
+         * @return The Player described by the record. A SNAPSHOT record ignores `previous`.
+         * @throws std::invalid_argument If the record is malformed or does not match the
+         *  dimensions of `previous`.
+         */
+        static Player applyDelta(const Player& previous, const std::uint8_t* data, size_t size);
+
+        /**
+         * @brief Applies a record produced by `encodeDelta` to a base Player.
+         * @param previous A const ref. to the Player the delta was encoded against.
+         * @param bytes A const ref. to the bytes of the record.
+         * @return The Player described by the record. A SNAPSHOT record ignores `previous`.
+         * @throws std::invalid_argument If the record is malformed or does not match the
+         *  dimensions of `previous`.
+         */
+        static Player applyDelta(const Player& previous, const std::vector<std::uint8_t>& bytes);
+};
+
+/**
+* @brief A read-only view of a SNAPSHOT record that answers queries in place.
+* Nothing is decoded up front: the view only locates the record's sections,
+* and each query reads the packed columns directly. The viewed bytes must
+* outlive the view.
+*/
+class PlayerCodec::RecordView {
+    private:
+        // The first byte of the record and the number of bytes it may span
+        const std::uint8_t* data_;
+        size_t size_;
+
+        // Dimensions copied from the fixed header. Its totals are recomputed from the columns instead.
+        size_t rows_;
+        size_t cols_;
+
+        // The width in bytes of each name id
+        std::uint8_t id_width_;
+
+        // The player name, viewing the record's bytes
+        std::string_view name_;
+
+        // The name table: entry end offsets, then the concatenated entry bytes
+        const std::uint8_t* name_ends_;
+        std::uint32_t name_count_;
+        const char* name_bytes_;
+        std::uint32_t name_bytes_size_;
+
+        // The equipped item's fields, or nullptr if nothing is equipped
+        const std::uint8_t* equipped_;
+
+        // The packed weight, type and name id columns
+        const std::uint8_t* weights_;
+        const std::uint8_t* types_;
+        const std::uint8_t* name_ids_;
+
+        /**
+         * @brief Resolves a name id against the record's name table.
+         * @throws std::invalid_argument If the id or its offsets are out of range.
+         */
+        std::string_view nameFor(std::uint32_t id) const;
+
+        /**
+         * @brief Builds an Item from a stored name id, weight and type.
+         */
+        Item itemAt(const std::uint8_t* nameId, const std::uint8_t* weight, std::uint8_t type) const;
+    public:
+        /**
+         * @brief Locates the sections of a SNAPSHOT record in O(1).
+         * @param data A pointer to the first byte of the record.
+         * @param size The number of bytes available at `data`.
+         * @throws std::invalid_argument If the bytes are not a SNAPSHOT record or
+         *  its sections do not fit in `size` bytes.
+         */
+        RecordView(const std::uint8_t* data, size_t size);
+
+        /**
+         * @brief Retrieves the player name stored in the record
+         * @return A view of the name, valid as long as the record's bytes are
+         */
+        std::string_view getName() const;
+
+        /**
+         * @brief Retrieves the first byte of the viewed record
+         * @return The value stored in `data_`, for copying the record without re-encoding it
+         */
+        const std::uint8_t* getData() const;
+
+        /**
+         * @brief Retrieves the length of the viewed record
+         * @return The value stored in `size_`
+         */
+        size_t getSize() const;
+
+        /**
+         * @brief Retrieves the number of rows of the encoded grid
+         * @return The grid's row count
+         */
+        size_t getRows() const;
+
+        /**
+         * @brief Retrieves the number of columns of the encoded grid
+         * @return The grid's column count
+         */
+        size_t getCols() const;
+
+        /**
+         * @brief Sums the weights of the encoded grid's items from the weight column
+         * @return The Inventory::getWeight() that decode() would give the Player. The header's
+         *  total weight is not consulted, so a stale or corrupt header cannot skew it.
+         * @note O(rows * cols): only the type and weight columns are read.
+         * @throws std::invalid_argument If a cell holds an invalid item type.
+         */
+        float getWeight() const;
+
+        /**
+         * @brief Counts the encoded grid's items from the type column
+         * @return The Inventory::getCount() that decode() would give the Player. decode() rejects
+         *  a record whose header count differs from it.
+         * @note O(rows * cols): only the type column is read.
+         * @throws std::invalid_argument If a cell holds an invalid item type.
+         */
+        size_t getCount() const;
+
+        /**
+         * @brief Reads one cell of the encoded grid.
+         * @param row The row index in the grid.
+         * @param col The column index in the grid.
+         * @return A copy of the cell's Item.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        Item at(size_t row, size_t col) const;
+
+        /**
+         * @brief Reads the encoded equipped item.
+         * @return A copy of the equipped Item, or std::nullopt if nothing was equipped.
+         */
+        std::optional<Item> getEquipped() const;
+
+        /**
+         * @brief Counts the cells of every ItemType by scanning the type column only.
+         * @return An array indexed by ItemType holding the number of cells of each type.
+         */
+        std::array<size_t, 4> countAllTypes() const;
+
+        /**
+         * @brief Decodes the whole record into a Player.
+         * @return The Player, as PlayerCodec::decode would build it.
+         */
+        Player materialize() const;
+};
@@ -0,0 +1,242 @@
+#include "RosterStream.hpp"
+#include "Guild.hpp"
+#include "MappedRoster.hpp"
+#include "PlayerCodec.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static constexpr char MAGIC[4] = {'M', 'R', 'S', 'T'};
+static constexpr size_t HEADER_SIZE = 8;
+
+/**
+* @brief Runs `produce` on a worker thread and `consume` on the calling thread, one chunk apart.
+*
+* @param produce Called as `bool produce(Chunk&)` to fill the next chunk; returns false
+*        once that chunk is the last one.
+* @param consume Called as `consume(Chunk&&)` with each chunk, in production order.
+* @note The worker blocks while a finished chunk is still waiting to be consumed, so at most
+*       three chunks exist at once. An exception from either stage stops both, and the first
+*       one is rethrown on the calling thread after the worker has joined.
+*/
+template <typename Chunk, typename Produce, typename Consume>
+static void runPipeline(Produce produce, Consume consume) {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::optional<Chunk> ready;  // The chunk handed over and not yet consumed
+    bool finished = false;       // The worker will hand over no more chunks
+    bool cancelled = false;      // The consumer failed; the worker should stop
+    std::exception_ptr failure;  // Written by the worker, read after it joins
+
+    std::thread producer([&]() {
+        try {
+            for (bool more = true; more;) {
+                Chunk chunk;
+                more = produce(chunk);
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return !ready || cancelled; });
+                if (cancelled) { break; }
+                ready = std::move(chunk);
+                changed.notify_all();
+            }
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        changed.notify_all();
+    });
+
+    try {
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return ready || finished; });
+            if (!ready) { break; }
+            Chunk chunk = std::move(*ready);
+            ready.reset();
+            changed.notify_all();
+            lock.unlock();
+            consume(std::move(chunk));
+        }
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            cancelled = true;
+            changed.notify_all();
+        }
+        producer.join();
+        throw;
+    }
+    producer.join();
+    if (failure) { std::rethrow_exception(failure); }
+}
+
+/**
+* @brief Appends a little-endian u32 to a byte buffer.
+*/
+static void appendU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (unsigned shift = 0; shift < 32; shift += 8) { out.push_back(static_cast<std::uint8_t>(value >> shift)); }
+}
+
+/**
+* @brief Appends one length-prefixed record to a byte buffer.
+*/
+static void appendRecord(std::vector<std::uint8_t>& out, const std::uint8_t* record, size_t size) {
+    if (size > RosterStream::MAX_RECORD_SIZE) { throw std::invalid_argument("Player is too large to stream."); }
+    appendU32(out, static_cast<std::uint32_t>(size));
+    out.insert(out.end(), record, record + size);
+}
+
+/**
+* @brief Writes a byte buffer to a stream.
+* @throws std::ios_base::failure If the stream fails.
+*/
+static void writeBytes(std::ostream& out, const std::uint8_t* bytes, size_t size) {
+    out.write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+    if (!out) { throw std::ios_base::failure("Cannot write roster stream."); }
+}
+
+/**
+* @brief Reads exactly `size` bytes from a stream.
+* @throws std::invalid_argument If the stream ends first.
+*/
+static void readBytes(std::istream& in, std::uint8_t* bytes, size_t size) {
+    in.read(reinterpret_cast<char*>(bytes), static_cast<std::streamsize>(size));
+    if (static_cast<size_t>(in.gcount()) != size) { throw std::invalid_argument("Truncated roster stream."); }
+}
+
+/**
+* @brief Reads the next length-prefixed record into `record`.
+* @return False if the end marker was read instead of a record.
+* @throws std::invalid_argument If the stream ends early or the length is implausible.
+*/
+static bool readRecord(std::istream& in, std::vector<std::uint8_t>& record) {
+    std::uint8_t prefix[4];
+    readBytes(in, prefix, sizeof(prefix));
+    std::uint32_t size = static_cast<std::uint32_t>(prefix[0]) | (static_cast<std::uint32_t>(prefix[1]) << 8)
+                       | (static_cast<std::uint32_t>(prefix[2]) << 16) | (static_cast<std::uint32_t>(prefix[3]) << 24);
+    if (size == 0) { return false; }
+    if (size > RosterStream::MAX_RECORD_SIZE) { throw std::invalid_argument("Corrupt roster stream record length."); }
+    record.resize(size);
+    readBytes(in, record.data(), size);
+    return true;
+}
+
+/**
+* @brief Streams every player of a guild out as length-prefixed records.
+* @param guild A const ref. to the Guild to export. It must not be mutated during the call.
+*  Cold players and those still only in an attached MappedRoster are copied byte for byte.
+* @param out The stream to write to.
+* @param chunkSize The number of players encoded per chunk. Defaults to DEFAULT_CHUNK.
+* @return The number of players written.
+* @throws std::ios_base::failure If `out` fails.
+*/
+size_t RosterStream::exportGuild(const Guild& guild, std::ostream& out, size_t chunkSize) {
+    chunkSize = std::max<size_t>(chunkSize, 1);
+
+    std::vector<std::uint8_t> header(MAGIC, MAGIC + sizeof(MAGIC));
+    header.push_back(static_cast<std::uint8_t>(FORMAT_VERSION));
+    header.push_back(static_cast<std::uint8_t>(FORMAT_VERSION >> 8));
+    header.insert(header.end(), 2, 0);
+    writeBytes(out, header.data(), header.size());
+
+    struct EncodedChunk {
+        size_t players;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    // Enlisted players first, then the still-mapped ones, then the cold ones; `next` walks all three in turn
+    size_t enlisted = guild.enlisted_players.size();
+    size_t mapped = guild.mapped_claimed_.size();
+    std::vector<const std::vector<std::uint8_t>*> coldRecords;
+    coldRecords.reserve(guild.cold_players_.size());
+    for (const auto& cold : guild.cold_players_) { coldRecords.push_back(&cold.second.record); }
+    size_t slots = enlisted + mapped + coldRecords.size();
+    size_t next = 0;
+    size_t written = 0;
+
+    runPipeline<EncodedChunk>(
+        [&](EncodedChunk& chunk) {
+            chunk.players = 0;
+            for (; next < slots && chunk.players < chunkSize; next++) {
+                if (next < enlisted) {
+                    // Encode in place behind a length prefix that is patched afterwards
+                    size_t prefix = chunk.bytes.size();
+                    appendU32(chunk.bytes, 0);
+                    PlayerCodec::encode(guild.enlisted_players[next], chunk.bytes);
+                    size_t size = chunk.bytes.size() - prefix - 4;
+                    if (size > MAX_RECORD_SIZE) { throw std::invalid_argument("Player is too large to stream."); }
+                    for (unsigned byte = 0; byte < 4; byte++) {
+                        chunk.bytes[prefix + byte] = static_cast<std::uint8_t>(size >> (byte * 8));
+                    }
+                } else if (next >= enlisted + mapped) {
+                    const std::vector<std::uint8_t>& record = *coldRecords[next - enlisted - mapped];
+                    appendRecord(chunk.bytes, record.data(), record.size());
+                } else if (!guild.mapped_claimed_[next - enlisted]) {
+                    PlayerCodec::RecordView record = guild.mapped_roster_->getRecord(next - enlisted);
+                    appendRecord(chunk.bytes, record.getData(), record.getSize());
+                } else {
+                    continue;
+                }
+                chunk.players++;
+            }
+            return next < slots;
+        },
+        [&](EncodedChunk&& chunk) {
+            writeBytes(out, chunk.bytes.data(), chunk.bytes.size());
+            written += chunk.players;
+        });
+
+    std::vector<std::uint8_t> end;
+    appendU32(end, 0);
+    writeBytes(out, end.data(), end.size());
+    return written;
+}
+
+/**
+* @brief Parses a roster stream and enlists its players into a guild in batches.
+* @param in The stream to read from.
+* @param guild An l-value ref. to the Guild the players are enlisted into.
+* @param chunkSize The number of players decoded per chunk. Defaults to DEFAULT_CHUNK.
+* @return The number of players enlisted. Players whose name is already
+*  in the guild are skipped, as Guild::enlistPlayers does.
+* @throws std::invalid_argument If the stream or one of its records is malformed.
+*  Players from chunks before the bad record stay enlisted.
+*
+* @post Each decoded Player is moved into the guild; no record is copied after decoding.
+*/
+size_t RosterStream::importGuild(std::istream& in, Guild& guild, size_t chunkSize) {
+    chunkSize = std::max<size_t>(chunkSize, 1);
+
+    std::uint8_t header[HEADER_SIZE];
+    readBytes(in, header, sizeof(header));
+    if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) { throw std::invalid_argument("Not a roster stream."); }
+    if ((header[4] | (header[5] << 8)) != FORMAT_VERSION) {
+        throw std::invalid_argument("Unsupported roster stream version.");
+    }
+
+    // Reused for every record, so parsing holds one raw record at a time
+    std::vector<std::uint8_t> record;
+    size_t enlisted = 0;
+
+    runPipeline<std::vector<Player>>(
+        [&](std::vector<Player>& chunk) {
+            chunk.reserve(chunkSize);
+            while (chunk.size() < chunkSize) {
+                if (!readRecord(in, record)) { return false; }
+                chunk.push_back(PlayerCodec::decode(record.data(), record.size()));
+            }
+            return true;
+        },
+        [&](std::vector<Player>&& chunk) {
+            std::vector<bool> accepted = guild.enlistPlayers(chunk);
+            enlisted += static_cast<size_t>(std::count(accepted.begin(), accepted.end(), true));
+        });
+    return enlisted;
+}
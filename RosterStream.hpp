@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+class Guild;
+
+/** Streaming import and export of whole guild rosters.
+*
+* Stream layout (little-endian):
+*
+*     magic "MRST", u16 format version (FORMAT_VERSION), u16 reserved
+*     per player: u32 record length, then a PlayerCodec SNAPSHOT record
+*     u32 zero, marking the end of the roster
+*
+* Both directions run as a two-stage pipeline: a worker thread produces the
+* next chunk of players (parsing on import, encoding on export) while the
+* calling thread consumes the previous one (enlisting, or writing it out).
+* At most three chunks are alive at a time (one being produced, one handed
+* over, one being consumed), so peak memory grows with the chunk size rather
+* than with the roster size.
+*/
+class RosterStream {
+    public:
+        // The format version written into, and required from, every stream
+        static constexpr std::uint16_t FORMAT_VERSION = 1;
+
+        // The players handed between the two pipeline stages at a time, if none provided
+        static constexpr size_t DEFAULT_CHUNK = 256;
+
+        // The largest record length accepted on import, guarding against corrupt lengths
+        static constexpr std::uint32_t MAX_RECORD_SIZE = 1u << 28;
+
+        /**
+         * @brief Streams every player of a guild out as length-prefixed records.
+         * @param guild A const ref. to the Guild to export. It must not be mutated during the call.
+         *  Cold players and those still only in an attached MappedRoster are copied byte for byte.
+         * @param out The stream to write to.
+         * @param chunkSize The number of players encoded per chunk. Defaults to DEFAULT_CHUNK.
+         * @return The number of players written.
+         * @throws std::ios_base::failure If `out` fails.
+         */
+        static size_t exportGuild(const Guild& guild, std::ostream& out, size_t chunkSize = DEFAULT_CHUNK);
+
+        /**
+         * @brief Parses a roster stream and enlists its players into a guild in batches.
+         * @param in The stream to read from.
+         * @param guild An l-value ref. to the Guild the players are enlisted into.
+         * @param chunkSize The number of players decoded per chunk. Defaults to DEFAULT_CHUNK.
+         * @return The number of players enlisted. Players whose name is already
+         *  in the guild are skipped, as Guild::enlistPlayers does.
+         * @throws std::invalid_argument If the stream or one of its records is malformed.
+         *  Players from chunks before the bad record stay enlisted.
+         *
+         * @post Each decoded Player is moved into the guild; no record is copied after decoding.
+         */
+        static size_t importGuild(std::istream& in, Guild& guild, size_t chunkSize = DEFAULT_CHUNK);
+};
@@ -0,0 +1,186 @@
+#include "SnapshotInventory.hpp"
+#include <limits>
+
+/**
+ * Epoch-based reclamation shared by every SnapshotInventory.
+ *
+ * Each reading thread owns a ReaderRecord. While a thread holds a Snapshot, its record
+ * carries the global epoch observed when it pinned (0 means not reading). A writer
+ * retires the version it replaces at the current epoch, then advances the epoch.
+ * A retired version can be deleted once every pinned reader carries a later epoch,
+ * since those readers loaded `current_` after the replacement.
+ */
+struct ReaderRecord {
+    std::atomic<std::uint64_t> epoch{0};  // The pinned epoch, or 0 when not reading
+    std::atomic<bool> in_use{false};      // Whether a live thread owns this record
+    ReaderRecord* next = nullptr;         // The next record in `reader_records`
+};
+
+// Starts at 1 so that 0 can mean "not pinned"
+static std::atomic<std::uint64_t> global_epoch{1};
+
+// Every record ever created. Records are recycled between threads but never freed.
+static std::atomic<ReaderRecord*> reader_records{nullptr};
+
+/**
+ * @brief Claims a free record for the calling thread, or creates one.
+ * @return A record owned by the calling thread until it exits.
+ */
+static ReaderRecord* claimReaderRecord() {
+    for (ReaderRecord* record = reader_records.load(); record; record = record->next) {
+        bool expected = false;
+        if (record->in_use.compare_exchange_strong(expected, true)) { return record; }
+    }
+    ReaderRecord* record = new ReaderRecord();
+    record->in_use.store(true);
+    record->next = reader_records.load();
+    while (!reader_records.compare_exchange_weak(record->next, record)) {}
+    return record;
+}
+
+/**
+ * @brief The calling thread's record and Snapshot nesting depth.
+ * Releases the record for reuse when the thread exits.
+ */
+struct ThreadReader {
+    ReaderRecord* record = claimReaderRecord();
+    size_t depth = 0;
+
+    ~ThreadReader() { record->in_use.store(false); }
+};
+
+/**
+ * @brief Retrieves the calling thread's reader state.
+ * @return A reference to the thread_local ThreadReader.
+ */
+static ThreadReader& threadReader() {
+    thread_local ThreadReader reader;
+    return reader;
+}
+
+/**
+ * @brief Pins the current epoch for the calling thread. Nested pins are counted.
+ */
+static void pinEpoch() {
+    ThreadReader& reader = threadReader();
+    if (reader.depth++ > 0) { return; }
+    // Re-check so a writer scanning records cannot miss a pin taken at a stale epoch
+    std::uint64_t epoch = global_epoch.load();
+    reader.record->epoch.store(epoch);
+    while (global_epoch.load() != epoch) {
+        epoch = global_epoch.load();
+        reader.record->epoch.store(epoch);
+    }
+}
+
+/**
+ * @brief Releases the calling thread's pin once the outermost Snapshot ends.
+ */
+static void unpinEpoch() {
+    ThreadReader& reader = threadReader();
+    if (--reader.depth == 0) { reader.record->epoch.store(0); }
+}
+
+/**
+ * @brief Finds the oldest epoch still pinned by any reader.
+ * @return The smallest pinned epoch, or the maximum uint64_t if nobody is reading.
+ */
+static std::uint64_t oldestPinnedEpoch() {
+    std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+    for (ReaderRecord* record = reader_records.load(); record; record = record->next) {
+        std::uint64_t epoch = record->epoch.load();
+        if (epoch != 0 && epoch < oldest) { oldest = epoch; }
+    }
+    return oldest;
+}
+
+/**
+ * @brief Unpins the version, allowing it to be reclaimed once retired.
+ * NOTE: Must run on the thread that called read().
+ */
+SnapshotInventory::Snapshot::~Snapshot() {
+    unpinEpoch();
+}
+
+/**
+ * @brief Constructs a SnapshotInventory whose first version is `initial`.
+ * @param initial The Inventory to publish. Defaults to a default constructed Inventory.
+ */
+SnapshotInventory::SnapshotInventory(Inventory initial)
+        : current_(new Inventory(std::move(initial))), writer_mutex_(), retired_() {}
+
+/**
+ * @brief Destroys every version.
+ * NOTE: No Snapshot of this SnapshotInventory may outlive it.
+ */
+SnapshotInventory::~SnapshotInventory() {
+    for (const RetiredVersion& version : retired_) { delete version.inventory; }
+    delete current_.load();
+}
+
+/**
+ * @brief Pins the current version for lock-free reading.
+ * @return A Snapshot of the latest published version. Its `weight_`
+ *  and `item_count_` always agree with its grid. Returned by guaranteed
+ *  copy elision, e.g. `auto snapshot = inventory.read();`.
+ */
+SnapshotInventory::Snapshot SnapshotInventory::read() const {
+    pinEpoch();
+    return Snapshot(current_.load());
+}
+
+/**
+ * @brief Swaps in a new version and reclaims retired versions no reader can still see.
+ * @param next The new version. Ownership passes to this SnapshotInventory.
+ * NOTE: The caller must hold `writer_mutex_`.
+ */
+void SnapshotInventory::publish(Inventory* next) {
+    const Inventory* replaced = current_.exchange(next);
+    // Readers pinned at or before this epoch may still hold `replaced`
+    retired_.push_back(RetiredVersion{replaced, global_epoch.fetch_add(1)});
+
+    std::uint64_t oldest = oldestPinnedEpoch();
+    size_t kept = 0;
+    for (const RetiredVersion& version : retired_) {
+        if (version.retired_at < oldest) {
+            delete version.inventory;
+        } else {
+            retired_[kept++] = version;
+        }
+    }
+    retired_.resize(kept);
+}
+
+/**
+ * @brief Stores an item through `write`, publishing a new version on success.
+ * @param row A size_t parameter for the row index in the inventory grid.
+ * @param col A size_t parameter for the column index in the inventory grid.
+ * @param pickup A const ref. to the item to store at the specified location.
+ * @return True if the item was successfully stored, false if the cell is already occupied.
+ * @throws std::out_of_range If the row or column is out of bounds.
+ */
+bool SnapshotInventory::store(const size_t& row, const size_t& col, const Item& pickup) {
+    return write([&](Inventory& next) { return next.store(row, col, pickup); });
+}
+
+/**
+ * @brief Equips an item through `write`.
+ * @param itemToEquip A pointer to the item to equip, allocated with `new`.
+ * @post The new version owns `itemToEquip`. Every version owns its own copy of
+ *  its equipped item, so the new version's copy of the previous item is discarded
+ *  while older snapshots keep theirs.
+ */
+void SnapshotInventory::equip(Item* itemToEquip) {
+    write([&](Inventory& next) {
+        next.discardEquipped();
+        next.equip(itemToEquip);
+    });
+}
+
+/**
+ * @brief Discards the equipped item through `write`.
+ * @post The new version has no equipped item. Older versions keep their own copy.
+ */
+void SnapshotInventory::discardEquipped() {
+    write([](Inventory& next) { next.discardEquipped(); });
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Inventory.hpp"
+
+class SnapshotInventory {
+    public:
+        /**
+         * @brief A pinned, immutable version of the inventory.
+         * While a Snapshot is alive the version it points to is never reclaimed,
+         * even if writers publish newer ones. Reading through it takes no locks.
+         * NOTE: Keep snapshots short-lived; a pinned version delays reclamation
+         *       of every version retired after it (never the writers themselves).
+         * NOTE: A Snapshot is thread-affine: the pin belongs to the thread that called read(),
+         *       so it can be neither copied nor moved, and must be destroyed on that thread.
+         */
+        class Snapshot {
+            private:
+                // The pinned version
+                const Inventory* inventory_;
+
+                friend class SnapshotInventory;
+                explicit Snapshot(const Inventory* inventory) : inventory_(inventory) {}
+            public:
+                Snapshot(const Snapshot&) = delete;
+                Snapshot& operator=(const Snapshot&) = delete;
+                Snapshot(Snapshot&&) = delete;
+                Snapshot& operator=(Snapshot&&) = delete;
+
+                /**
+                 * @brief Unpins the version, allowing it to be reclaimed once retired.
+                 * NOTE: Must run on the thread that called read().
+                 */
+                ~Snapshot();
+
+                const Inventory& operator*() const { return *inventory_; }
+                const Inventory* operator->() const { return inventory_; }
+        };
+
+    private:
+        /**
+         * @brief A replaced version waiting for every reader that might see it to unpin.
+         */
+        struct RetiredVersion {
+            const Inventory* inventory; // The replaced version
+            std::uint64_t retired_at;   // The global epoch at the moment it was replaced
+        };
+
+        // The most recently published version
+        std::atomic<const Inventory*> current_;
+
+        // Serializes writers; readers never take it
+        std::mutex writer_mutex_;
+
+        // Versions replaced by writers but possibly still pinned by readers. Guarded by `writer_mutex_`.
+        std::vector<RetiredVersion> retired_;
+
+        /**
+         * @brief Swaps in a new version and reclaims retired versions no reader can still see.
+         * @param next The new version. Ownership passes to this SnapshotInventory.
+         * NOTE: The caller must hold `writer_mutex_`.
+         */
+        void publish(Inventory* next);
+
+    public:
+        /**
+         * @brief Constructs a SnapshotInventory whose first version is `initial`.
+         * @param initial The Inventory to publish. Defaults to a default constructed Inventory.
+         */
+        explicit SnapshotInventory(Inventory initial = Inventory());
+
+        SnapshotInventory(const SnapshotInventory&) = delete;
+        SnapshotInventory& operator=(const SnapshotInventory&) = delete;
+
+        /**
+         * @brief Destroys every version.
+         * NOTE: No Snapshot of this SnapshotInventory may outlive it.
+         */
+        ~SnapshotInventory();
+
+        /**
+         * @brief Pins the current version for lock-free reading.
+         * @return A Snapshot of the latest published version. Its `weight_`
+         *  and `item_count_` always agree with its grid. Returned by guaranteed
+         *  copy elision, e.g. `auto snapshot = inventory.read();`.
+         */
+        Snapshot read() const;
+
+        /**
+         * @brief Applies a mutation to a private copy and publishes it as the new version.
+         * @param mutate A callable invoked as mutate(Inventory&) on a copy of the current version.
+         * @return Whatever `mutate` returns.
+         * @post Readers that pinned an older version keep seeing it unchanged.
+         *  The copy shares its grid with the old version until `mutate` writes to it.
+         *  If `mutate` throws, nothing is published.
+         */
+        template <typename Mutator>
+        auto write(Mutator mutate) -> decltype(mutate(std::declval<Inventory&>())) {
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            Inventory next(*current_.load());
+            if constexpr (std::is_void<decltype(mutate(next))>::value) {
+                mutate(next);
+                publish(new Inventory(std::move(next)));
+            } else {
+                auto result = mutate(next);
+                publish(new Inventory(std::move(next)));
+                return result;
+            }
+        }
+
+        /**
+         * @brief Stores an item through `write`, publishing a new version on success.
+         * @param row A size_t parameter for the row index in the inventory grid.
+         * @param col A size_t parameter for the column index in the inventory grid.
+         * @param pickup A const ref. to the item to store at the specified location.
+         * @return True if the item was successfully stored, false if the cell is already occupied.
+         * @throws std::out_of_range If the row or column is out of bounds.
+         */
+        bool store(const size_t& row, const size_t& col, const Item& pickup);
+
+        /**
+         * @brief Equips an item through `write`.
+         * @param itemToEquip A pointer to the item to equip, allocated with `new`.
+         * @post The new version owns `itemToEquip`. Every version owns its own copy of
+         *  its equipped item, so the new version's copy of the previous item is discarded
+         *  while older snapshots keep theirs.
+         */
+        void equip(Item* itemToEquip);
+
+        /**
+         * @brief Discards the equipped item through `write`.
+         * @post The new version has no equipped item. Older versions keep their own copy.
+         */
+        void discardEquipped();
+};
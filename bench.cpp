@@ -0,0 +1,267 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "ConcurrentGuild.hpp"
+#include "Guild.hpp"
+
+// Run through `make bench`, which writes the results to bench.json.
+// Grid benchmarks take the side length of a square grid; Guild benchmarks take the member count.
+
+/**
+ * @brief Builds a full square inventory with an equipped item.
+ * @param side The number of rows and columns.
+ * @return An Inventory whose every cell holds an item.
+ */
+static Inventory makeInventory(size_t side) {
+    std::vector<Item> cells(side * side, Item("Greater Health Potion of the Northern Wastes", 0.5, ACCESSORY));
+    return Inventory(side, side, std::move(cells), new Item("Tower Shield of the Fallen Keep", 12.0, ARMOR));
+}
+
+/**
+ * @brief Builds the name of the i-th benchmark player.
+ */
+static std::string playerName(size_t i) {
+    return "Player" + std::to_string(i);
+}
+
+/**
+ * @brief Builds a guild of `count` players sharing one small loadout.
+ * @param count The number of players to enlist.
+ * @return The filled Guild. The players' grids are shared copy-on-write, so large guilds stay cheap.
+ */
+static Guild makeGuild(size_t count) {
+    Inventory loadout = makeInventory(2);
+    Guild guild;
+    std::vector<Player> players;
+    players.reserve(count);
+    for (size_t i = 0; i < count; i++) { players.emplace_back(playerName(i), loadout); }
+    guild.enlistPlayers(players);
+    return guild;
+}
+
+static void gridSizes(benchmark::internal::Benchmark* bench) {
+    bench->RangeMultiplier(4)->Range(4, 256);
+}
+
+static void guildSizes(benchmark::internal::Benchmark* bench) {
+    bench->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+}
+
+// Inventory and Player: the Big Five
+
+static void BM_InventoryCopyConstruct(benchmark::State& state) {
+    Inventory source = makeInventory(state.range(0));
+    for (auto _ : state) {
+        Inventory copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_InventoryCopyConstruct)->Apply(gridSizes);
+
+// A copy followed by its first write, which pays for duplicating the shared grid
+static void BM_InventoryCopyThenStore(benchmark::State& state) {
+    size_t side = state.range(0);
+    std::vector<Item> cells(side * side, Item("Greater Health Potion of the Northern Wastes", 0.5, ACCESSORY));
+    cells[0] = Item(); // Leaves (0, 0) free for the write
+    Inventory source(side, side, std::move(cells));
+    for (auto _ : state) {
+        Inventory copy(source);
+        copy.store(0, 0, Item("Rusty Dagger", 1.0, WEAPON));
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_InventoryCopyThenStore)->Apply(gridSizes);
+
+static void BM_InventoryMoveConstruct(benchmark::State& state) {
+    Inventory source = makeInventory(state.range(0));
+    for (auto _ : state) {
+        Inventory moved(std::move(source));
+        source = std::move(moved);
+        benchmark::DoNotOptimize(source);
+    }
+}
+BENCHMARK(BM_InventoryMoveConstruct)->Apply(gridSizes);
+
+static void BM_InventoryCopyAssign(benchmark::State& state) {
+    Inventory source = makeInventory(state.range(0));
+    Inventory target = makeInventory(state.range(0));
+    for (auto _ : state) {
+        target = source;
+        benchmark::DoNotOptimize(target);
+    }
+}
+BENCHMARK(BM_InventoryCopyAssign)->Apply(gridSizes);
+
+static void BM_InventoryMoveAssign(benchmark::State& state) {
+    Inventory first = makeInventory(state.range(0));
+    Inventory second = makeInventory(state.range(0));
+    for (auto _ : state) {
+        second = std::move(first);
+        first = std::move(second);
+        benchmark::DoNotOptimize(first);
+    }
+}
+BENCHMARK(BM_InventoryMoveAssign)->Apply(gridSizes);
+
+static void BM_PlayerCopyConstruct(benchmark::State& state) {
+    Player source("Benchmark Player With A Long Name", makeInventory(state.range(0)));
+    for (auto _ : state) {
+        Player copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_PlayerCopyConstruct)->Apply(gridSizes);
+
+static void BM_PlayerMoveConstruct(benchmark::State& state) {
+    Player source("Benchmark Player With A Long Name", makeInventory(state.range(0)));
+    for (auto _ : state) {
+        Player moved(std::move(source));
+        source = std::move(moved);
+        benchmark::DoNotOptimize(source);
+    }
+}
+BENCHMARK(BM_PlayerMoveConstruct)->Apply(gridSizes);
+
+static void BM_PlayerCopyAssign(benchmark::State& state) {
+    Player source("Benchmark Player With A Long Name", makeInventory(state.range(0)));
+    Player target("Target", makeInventory(state.range(0)));
+    for (auto _ : state) {
+        target = source;
+        benchmark::DoNotOptimize(target);
+    }
+}
+BENCHMARK(BM_PlayerCopyAssign)->Apply(gridSizes);
+
+static void BM_PlayerMoveAssign(benchmark::State& state) {
+    Player first("Benchmark Player With A Long Name", makeInventory(state.range(0)));
+    Player second("Target", makeInventory(state.range(0)));
+    for (auto _ : state) {
+        second = std::move(first);
+        first = std::move(second);
+        benchmark::DoNotOptimize(first);
+    }
+}
+BENCHMARK(BM_PlayerMoveAssign)->Apply(gridSizes);
+
+// Guild operations
+
+// Enlists a whole roster into an empty guild; items/s is the per-player rate
+static void BM_GuildEnlistPlayer(benchmark::State& state) {
+    size_t count = state.range(0);
+    Inventory loadout = makeInventory(2);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Player> players;
+        players.reserve(count);
+        for (size_t i = 0; i < count; i++) { players.emplace_back(playerName(i), loadout); }
+        Guild guild;
+        state.ResumeTiming();
+
+        for (Player& player : players) { guild.enlistPlayer(player); }
+        benchmark::DoNotOptimize(guild);
+
+        state.PauseTiming();
+        players.clear();
+        guild = Guild(); // Destruction is not part of the measurement
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_GuildEnlistPlayer)->Apply(guildSizes);
+
+// Moves one player out and back again; each iteration is two movePlayerTo calls
+static void BM_GuildMovePlayerTo(benchmark::State& state) {
+    size_t count = state.range(0);
+    Guild source = makeGuild(count);
+    source.setRemovalPolicy(state.range(1) ? RemovalPolicy::UNORDERED : RemovalPolicy::STABLE);
+    Guild target;
+    size_t i = 0;
+    for (auto _ : state) {
+        std::string name = playerName(i++ % count);
+        source.movePlayerTo(name, target);
+        target.movePlayerTo(name, source);
+    }
+    state.SetLabel(state.range(1) ? "UNORDERED" : "STABLE");
+}
+BENCHMARK(BM_GuildMovePlayerTo)
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 32), {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// Copies distinct players into a target guild, which is emptied off the clock once it holds everyone
+static void BM_GuildCopyPlayerTo(benchmark::State& state) {
+    size_t count = state.range(0);
+    Guild source = makeGuild(count);
+    Guild target;
+    size_t i = 0;
+    for (auto _ : state) {
+        if (i == count) {
+            state.PauseTiming();
+            target = Guild();
+            i = 0;
+            state.ResumeTiming();
+        }
+        source.copyPlayerTo(playerName(i++), target);
+    }
+}
+BENCHMARK(BM_GuildCopyPlayerTo)->Apply(guildSizes);
+
+static void BM_GuildFindPlayerHit(benchmark::State& state) {
+    size_t count = state.range(0);
+    const Guild guild = makeGuild(count);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 4096; i++) { names.push_back(playerName((i * 7919) % count)); }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(guild.findPlayer(names[i++ % names.size()]));
+    }
+}
+BENCHMARK(BM_GuildFindPlayerHit)->Apply(guildSizes)->Unit(benchmark::kNanosecond);
+
+static void BM_GuildFindPlayerMiss(benchmark::State& state) {
+    size_t count = state.range(0);
+    const Guild guild = makeGuild(count);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 4096; i++) { names.push_back("Absent" + std::to_string(i)); }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(guild.findPlayer(names[i++ % names.size()]));
+    }
+}
+BENCHMARK(BM_GuildFindPlayerMiss)->Apply(guildSizes)->Unit(benchmark::kNanosecond);
+
+// ConcurrentGuild contention
+
+// Shuttles players between two sharded guilds from several threads at once; the first argument is the
+// shard count, so 1 is the single-lock baseline. Each thread owns its own players, so every move succeeds
+// and the threads contend only for the shard locks.
+static void BM_ConcurrentGuildMovePlayerTo(benchmark::State& state) {
+    constexpr size_t PER_THREAD = 256;
+    static ConcurrentGuild* east = nullptr;
+    static ConcurrentGuild* west = nullptr;
+    if (state.thread_index() == 0) {
+        east = new ConcurrentGuild(state.range(0));
+        west = new ConcurrentGuild(state.range(0));
+        Inventory loadout = makeInventory(2);
+        for (size_t i = 0; i < PER_THREAD * state.threads(); i++) {
+            Player player(playerName(i), loadout);
+            east->enlistPlayer(player);
+        }
+    }
+    // Setup above finishes before any thread enters the loop, and teardown waits for all of them to leave it
+    std::vector<std::string> names;
+    for (size_t i = 0; i < PER_THREAD; i++) { names.push_back(playerName(state.thread_index() * PER_THREAD + i)); }
+    size_t i = 0;
+    for (auto _ : state) {
+        size_t index = i++;
+        const std::string& name = names[index % PER_THREAD];
+        bool westward = index / PER_THREAD % 2 == 0; // Everyone goes west, then everyone comes back
+        (westward ? east : west)->movePlayerTo(name, westward ? *west : *east);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete east;
+        delete west;
+    }
+}
+BENCHMARK(BM_ConcurrentGuildMovePlayerTo)->Arg(1)->Arg(16)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,57 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Player.hpp"
+
+/**
+ * @brief A Player whose move constructor is not declared noexcept,
+ *  reproducing the roster before the Big Five were marked noexcept.
+ *  std::vector copies such elements instead of moving them when it grows.
+ */
+struct ThrowingMovePlayer : Player {
+    ThrowingMovePlayer(const std::string& name, const Inventory& inventory) : Player(name, inventory) {}
+    ThrowingMovePlayer(const ThrowingMovePlayer& rhs) = default;
+    ThrowingMovePlayer(ThrowingMovePlayer&& rhs) noexcept(false) : Player(std::move(rhs)) {}
+};
+
+/**
+ * @brief Builds the inventory every benchmarked player starts with.
+ * @return A full 10x10 Inventory with an equipped item.
+ */
+Inventory makeLoadout() {
+    Item potion("Greater Health Potion of the Northern Wastes", 0.5, ACCESSORY);
+    std::vector<std::vector<Item>> items(10, std::vector<Item>(10, potion));
+    return Inventory(items, new Item("Tower Shield of the Fallen Keep", 12.0, ARMOR));
+}
+
+/**
+ * @brief Times pushing `count` players into a vector that is never reserved.
+ * @param count The number of players to push.
+ * @param loadout The inventory copied into every player.
+ * @return The elapsed wall time in milliseconds.
+ */
+template <typename PlayerType>
+double timeRosterGrowth(size_t count, const Inventory& loadout) {
+    std::vector<PlayerType> players;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        players.push_back(PlayerType("Player" + std::to_string(i), loadout));
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @brief Compares roster growth with copying and with noexcept moving relocations.
+ */
+int main() {
+    Inventory loadout = makeLoadout();
+    std::cout << "players, copy-on-grow ms, move-on-grow ms\n";
+    for (size_t count : {1000, 10000, 50000}) {
+        double copying = timeRosterGrowth<ThrowingMovePlayer>(count, loadout);
+        double moving = timeRosterGrowth<Player>(count, loadout);
+        std::cout << count << ", " << copying << ", " << moving << "\n";
+    }
+    return 0;
+}
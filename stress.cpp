@@ -0,0 +1,490 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+#include "Guild.hpp"
+#include "GuildInbox.hpp"
+#include "Instrumentation.hpp"
+
+// A soak test for move-heavy guild workloads. Run `./stress --help` for the options.
+// Each worker thread owns a slice of the guilds and runs a weighted mix of operations against them;
+// transfers to a guild owned by another worker go through that guild's GuildInbox.
+// Build with `make stress INSTRUMENT=1` to also check that every Item, Inventory and Player was freed.
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief The operations of the mix. DRAIN is not drawn from the mix: it times each inbox drain.
+ */
+enum Operation { ENLIST, TRANSFER, COPY, LOOT, EQUIP, LEAVE, DRAIN, OPERATION_COUNT };
+
+static const char* const OPERATION_NAMES[OPERATION_COUNT] = {
+    "enlist", "transfer", "copy", "loot", "equip", "leave", "drain",
+};
+
+/**
+ * @brief A latency histogram with 32 linear sub-buckets per power of two of nanoseconds.
+ * Each recorded value lands in a bucket at most ~3% wider than the value, so percentiles
+ * are accurate to that bound from 1 ns up to 2^44 ns (about 4.9 hours); longer values share the last bucket.
+ */
+struct LatencyHistogram {
+    static constexpr size_t SUB_BUCKETS = 32;
+    static constexpr size_t BUCKETS = SUB_BUCKETS * 40;
+
+    std::array<std::uint64_t, BUCKETS> counts{};
+    std::uint64_t total = 0;
+    std::uint64_t max = 0;
+
+    // Values below SUB_BUCKETS get a bucket each; above, `nanos >> shift` falls in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    static size_t bucketFor(std::uint64_t nanos) {
+        if (nanos < SUB_BUCKETS) { return static_cast<size_t>(nanos); }
+        size_t shift = 63 - static_cast<size_t>(__builtin_clzll(nanos)) - 5; // log2(nanos) - log2(SUB_BUCKETS)
+        return std::min(BUCKETS - 1, shift * SUB_BUCKETS + static_cast<size_t>(nanos >> shift));
+    }
+
+    // The largest value that maps to `bucket`
+    static std::uint64_t upperBound(size_t bucket) {
+        if (bucket < SUB_BUCKETS) { return bucket; }
+        size_t shift = bucket / SUB_BUCKETS - 1;
+        std::uint64_t sub = bucket % SUB_BUCKETS + SUB_BUCKETS;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    void record(std::uint64_t nanos) {
+        counts[bucketFor(nanos)]++;
+        total++;
+        max = std::max(max, nanos);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t bucket = 0; bucket < counts.size(); bucket++) { counts[bucket] += other.counts[bucket]; }
+        total += other.total;
+        max = std::max(max, other.max);
+    }
+
+    // The smallest bucket bound that covers at least `quantile` of the recorded values
+    std::uint64_t percentile(double quantile) const {
+        if (total == 0) { return 0; }
+        std::uint64_t rank = static_cast<std::uint64_t>(quantile * static_cast<double>(total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < counts.size(); bucket++) {
+            seen += counts[bucket];
+            if (seen >= rank) { return std::min(upperBound(bucket), max); }
+        }
+        return max;
+    }
+};
+
+/**
+ * @brief The command-line configuration.
+ */
+struct StressConfig {
+    size_t guilds = 8;            // The number of guilds, split across the workers
+    size_t players = 2000;        // The players enlisted in each guild up front
+    size_t threads = 1;           // The number of worker threads
+    double seconds = 10;          // How long to run the mix
+    double rate = 0;              // Target operations per second per worker; 0 runs unthrottled
+    double report = 1;            // Seconds between RSS lines
+    size_t instanceSize = 40;     // Copies an instance guild takes before it is torn down
+    std::uint64_t seed = 1;       // Seeds every worker's generator
+    std::array<unsigned, DRAIN> mix{{5, 30, 10, 30, 20, 5}}; // Relative weights of ENLIST..LEAVE
+};
+
+/**
+ * @brief One worker's guilds, generator and measurements.
+ */
+struct Worker {
+    size_t id;
+    std::vector<size_t> owned;                      // Indexes of the guilds this worker owns
+    std::mt19937_64 rng;
+    std::uint64_t nextPlayer = 0;                   // Makes every enlisted name unique across workers
+    std::array<LatencyHistogram, OPERATION_COUNT> latencies;
+    std::atomic<std::uint64_t> operations{0};       // Published for the RSS reporter
+    std::atomic<std::uint64_t> latePasses{0};       // Operations started behind schedule under --rate
+};
+
+/**
+ * @brief The guilds shared by every worker. Only a guild's owner touches the guild itself;
+ * any worker may post to its inbox or read its published size.
+ */
+struct World {
+    std::vector<std::unique_ptr<Guild>> guilds;
+    std::vector<std::unique_ptr<GuildInbox>> inboxes;
+    std::unique_ptr<std::atomic<size_t>[]> sizes; // Each guild's enlisted players, as last published by its owner
+};
+
+/**
+ * @brief Reads the resident set size of this process.
+ * @return The RSS in KiB, or 0 if /proc is unavailable.
+ */
+static std::uint64_t residentKiB() {
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t size = 0;
+    std::uint64_t resident = 0;
+    if (!(statm >> size >> resident)) { return 0; }
+    return resident * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+static const char* const LOOT_NAMES[] = {
+    "Rusty Dagger", "Greater Health Potion of the Northern Wastes", "Ring of Haste", "Tower Shield of the Fallen Keep",
+    "Arrow", "Elixir", "Amulet of the Seventh Realm", "Leather Cap",
+};
+
+/**
+ * @brief Draws a random loot item.
+ */
+static Item randomLoot(std::mt19937_64& rng) {
+    const char* name = LOOT_NAMES[rng() % (sizeof(LOOT_NAMES) / sizeof(LOOT_NAMES[0]))];
+    return Item(name, static_cast<float>(rng() % 200) / 10.0f, static_cast<ItemType>(1 + rng() % 3));
+}
+
+/**
+ * @brief Builds a fresh 10x10 inventory a quarter full, with an equipped item half the time.
+ */
+static Inventory randomLoadout(std::mt19937_64& rng) {
+    std::vector<Item> cells(100);
+    for (size_t i = 0; i < 25; i++) { cells[rng() % cells.size()] = randomLoot(rng); }
+    Item* equipped = (rng() % 2) ? new Item(randomLoot(rng)) : nullptr;
+    return Inventory(10, 10, std::move(cells), equipped);
+}
+
+/**
+ * @brief Picks a random enlisted player among the worker's guilds, each player equally likely.
+ * Picking the guild by size keeps transfers from draining a small guild dry while big ones hoard the players.
+ * @return The player's guild and name, or {nullptr, ""} if the worker's guilds are all empty.
+ */
+static std::pair<Guild*, std::string> randomMember(Worker& worker, World& world) {
+    size_t members = 0;
+    for (size_t index : worker.owned) { members += world.guilds[index]->getPlayers().size(); }
+    if (members == 0) { return {nullptr, std::string()}; }
+    size_t pick = worker.rng() % members;
+    for (size_t index : worker.owned) {
+        const auto& players = world.guilds[index]->getPlayers();
+        if (pick < players.size()) { return {world.guilds[index].get(), players[pick].getName()}; }
+        pick -= players.size();
+    }
+    return {nullptr, std::string()};
+}
+
+/**
+ * @brief Picks the guild a transfer from `source` goes to: the smaller of two random other guilds.
+ * Choosing uniformly would leave each worker's share of the players a random walk that ends
+ * with one worker's guilds empty; two choices pull every guild back towards the mean.
+ */
+static size_t pickTarget(Worker& worker, const World& world, const Guild& source) {
+    size_t candidates[2];
+    for (size_t& candidate : candidates) {
+        candidate = worker.rng() % world.guilds.size();
+        if (world.guilds[candidate].get() == &source) { candidate = (candidate + 1) % world.guilds.size(); }
+    }
+    size_t first = world.sizes[candidates[0]].load(std::memory_order_relaxed);
+    size_t second = world.sizes[candidates[1]].load(std::memory_order_relaxed);
+    return first <= second ? candidates[0] : candidates[1];
+}
+
+/**
+ * @brief Runs one operation of the mix against one of the worker's guilds.
+ * @return True if the operation ran, false if it was skipped for lack of a player.
+ */
+static bool runOperation(Operation operation, Worker& worker, World& world, std::unique_ptr<Guild>& instance,
+                         const StressConfig& config, Clock::time_point started) {
+    Guild* picked = world.guilds[worker.owned[worker.rng() % worker.owned.size()]].get();
+    std::string name;
+    if (operation != ENLIST) {
+        std::tie(picked, name) = randomMember(worker, world);
+        if (!picked) { return false; }
+    }
+    Guild& guild = *picked;
+
+    // Inputs are prepared before `started` is taken whenever they do not depend on the guild
+    switch (operation) {
+        case ENLIST: {
+            Player player("w" + std::to_string(worker.id) + "-p" + std::to_string(worker.nextPlayer++),
+                          randomLoadout(worker.rng));
+            started = std::max(started, Clock::now());
+            guild.enlistPlayer(player);
+            break;
+        }
+        case TRANSFER: {
+            size_t target = pickTarget(worker, world, guild);
+            started = std::max(started, Clock::now());
+            if (target % config.threads == worker.id) {
+                guild.movePlayerTo(name, *world.guilds[target]);
+            } else {
+                guild.movePlayerTo(name, *world.inboxes[target]); // Rejections cannot happen: names are unique
+            }
+            break;
+        }
+        case COPY: {
+            started = std::max(started, Clock::now());
+            guild.copyPlayerTo(name, *instance);
+            if (instance->getPlayerCount() >= config.instanceSize) { instance = std::make_unique<Guild>(); }
+            break;
+        }
+        case LOOT: {
+            Item loot = randomLoot(worker.rng);
+            size_t row = worker.rng() % 10;
+            size_t col = worker.rng() % 10;
+            started = std::max(started, Clock::now());
+            Inventory& inventory = guild.findPlayer(name)->getInventoryRef();
+            if (!inventory.autoStore(loot)) { inventory.take(row, col); } // A full bag drops something instead
+            break;
+        }
+        case EQUIP: {
+            Item* gear = new Item(randomLoot(worker.rng));
+            started = std::max(started, Clock::now());
+            Inventory& inventory = guild.findPlayer(name)->getInventoryRef();
+            if (inventory.getEquipped() && worker.rng() % 2) {
+                inventory.discardEquipped();
+                delete gear;
+            } else {
+                Item* previous = inventory.getEquipped();
+                inventory.equip(gear); // Hands ownership of `previous` back to us
+                delete previous;
+            }
+            break;
+        }
+        case LEAVE: {
+            started = std::max(started, Clock::now());
+            guild.releasePlayer(name);
+            break;
+        }
+        default:
+            return false;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count();
+    worker.latencies[operation].record(static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed, 0)));
+    return true;
+}
+
+/**
+ * @brief Drains every inbox of the worker's guilds, timing each drain that enlisted someone,
+ * then publishes the guilds' sizes.
+ */
+static void drainInboxes(Worker& worker, World& world) {
+    for (size_t index : worker.owned) {
+        Guild& guild = *world.guilds[index];
+        auto started = Clock::now();
+        if (world.inboxes[index]->drain(guild) > 0) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count();
+            worker.latencies[DRAIN].record(static_cast<std::uint64_t>(elapsed));
+        }
+        world.sizes[index].store(guild.getPlayers().size(), std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Runs the mix until `deadline`.
+ * NOTE: Under --rate, each operation is timed from when it was scheduled rather than when it
+ *       started, so a stall shows up in the tail of every operation queued behind it.
+ */
+static void runWorker(Worker& worker, World& world, const StressConfig& config, Clock::time_point deadline) {
+    std::discrete_distribution<int> pick(config.mix.begin(), config.mix.end());
+    std::unique_ptr<Guild> instance = std::make_unique<Guild>();
+    auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(config.rate > 0 ? 1.0 / config.rate : 0.0));
+    Clock::time_point scheduled = Clock::now();
+
+    for (std::uint64_t count = 0;; count++) {
+        if ((count & 63) == 0) {
+            drainInboxes(worker, world);
+            worker.operations.store(count, std::memory_order_relaxed);
+            if (Clock::now() >= deadline) { break; }
+        }
+        Clock::time_point started = Clock::now();
+        if (config.rate > 0) {
+            scheduled += interval;
+            if (scheduled > started) {
+                std::this_thread::sleep_until(scheduled);
+            } else {
+                worker.latePasses.fetch_add(1, std::memory_order_relaxed);
+            }
+            started = scheduled;
+        }
+        runOperation(static_cast<Operation>(pick(worker.rng)), worker, world, instance, config, started);
+    }
+}
+
+/**
+ * @brief Parses "enlist:5,transfer:30,..." into mix weights.
+ * @return False if an operation name or weight is invalid.
+ */
+static bool parseMix(const std::string& text, StressConfig& config) {
+    std::stringstream entries(text);
+    std::string entry;
+    while (std::getline(entries, entry, ',')) {
+        size_t colon = entry.find(':');
+        if (colon == std::string::npos) { return false; }
+        std::string name = entry.substr(0, colon);
+        auto known = std::find_if(OPERATION_NAMES, OPERATION_NAMES + DRAIN, [&](const char* op) { return name == op; });
+        if (known == OPERATION_NAMES + DRAIN) { return false; }
+        config.mix[known - OPERATION_NAMES] = static_cast<unsigned>(std::stoul(entry.substr(colon + 1)));
+    }
+    return std::any_of(config.mix.begin(), config.mix.end(), [](unsigned weight) { return weight > 0; });
+}
+
+static void printUsage() {
+    std::cout << "usage: stress [--guilds N] [--players N] [--threads N] [--seconds S] [--rate OPS]\n"
+                 "              [--report S] [--instance-size N] [--seed N] [--mix op:weight,...]\n"
+                 "  --rate     target operations per second per worker (0, the default, is unthrottled)\n"
+                 "  --mix      weights for enlist, transfer, copy, loot, equip and leave\n"
+                 "             (default enlist:5,transfer:30,copy:10,loot:30,equip:20,leave:5)\n";
+}
+
+/**
+ * @brief Parses the command line.
+ * @return False, after printing the usage, if an option is unknown or malformed.
+ */
+static bool parseArguments(int argc, char** argv, StressConfig& config) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string option = argv[i];
+            if (option == "--help" || i + 1 >= argc) { printUsage(); return false; }
+            std::string value = argv[++i];
+            if (option == "--guilds") { config.guilds = std::stoul(value); }
+            else if (option == "--players") { config.players = std::stoul(value); }
+            else if (option == "--threads") { config.threads = std::stoul(value); }
+            else if (option == "--seconds") { config.seconds = std::stod(value); }
+            else if (option == "--rate") { config.rate = std::stod(value); }
+            else if (option == "--report") { config.report = std::stod(value); }
+            else if (option == "--instance-size") { config.instanceSize = std::stoul(value); }
+            else if (option == "--seed") { config.seed = std::stoull(value); }
+            else if (option == "--mix") {
+                config.mix.fill(0);
+                if (!parseMix(value, config)) { printUsage(); return false; }
+            } else { printUsage(); return false; }
+        }
+    } catch (const std::exception&) { // std::stoul and friends on malformed numbers
+        printUsage();
+        return false;
+    }
+    if (config.threads == 0 || config.guilds < std::max<size_t>(2, config.threads) || config.report <= 0) {
+        std::cout << "stress: needs at least 2 guilds, at least one per thread, and a positive --report\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Prints the number of Items, Inventories, Players and equipped items still alive.
+ * @return True if nothing leaked, or if instrumentation is compiled out.
+ */
+static bool reportLeaks(const Instrumentation::Snapshot& before) {
+    if (!Instrumentation::ENABLED) {
+        std::cout << "leak check skipped: build with `make stress INSTRUMENT=1` to count live objects\n";
+        return true;
+    }
+    Instrumentation::Snapshot counts = Instrumentation::snapshot().since(before);
+    auto live = [&](Instrumentation::Counter first) {
+        std::int64_t created = 0;
+        for (int offset = 0; offset < 3; offset++) { // Constructed, copy constructed, move constructed
+            created += static_cast<std::int64_t>(counts.get(static_cast<Instrumentation::Counter>(first + offset)));
+        }
+        return created - static_cast<std::int64_t>(counts.get(static_cast<Instrumentation::Counter>(first + 5)));
+    };
+    std::int64_t items = live(Instrumentation::ITEM_CONSTRUCTED);
+    std::int64_t inventories = live(Instrumentation::INVENTORY_CONSTRUCTED);
+    std::int64_t players = live(Instrumentation::PLAYER_CONSTRUCTED);
+    std::int64_t equipped = static_cast<std::int64_t>(counts.get(Instrumentation::EQUIPPED_ALLOCATED))
+                          - static_cast<std::int64_t>(counts.get(Instrumentation::EQUIPPED_FREED));
+    std::cout << "live after teardown: items " << items << ", inventories " << inventories
+              << ", players " << players << ", equipped " << equipped << "\n";
+    return items == 0 && inventories == 0 && players == 0 && equipped == 0;
+}
+
+/**
+ * @brief Fills the guilds, runs the mix on every worker and prints RSS samples and latency percentiles.
+ * @return 0 on success, 1 on bad arguments, 2 if instrumented objects leaked.
+ */
+int main(int argc, char** argv) {
+    StressConfig config;
+    if (!parseArguments(argc, argv, config)) { return 1; }
+    Instrumentation::Snapshot before = Instrumentation::snapshot();
+    std::uint64_t startRss = residentKiB();
+
+    World world;
+    world.sizes = std::make_unique<std::atomic<size_t>[]>(config.guilds);
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (size_t id = 0; id < config.threads; id++) {
+        workers.push_back(std::make_unique<Worker>());
+        workers.back()->id = id;
+        workers.back()->rng.seed(config.seed * 1000003 + id);
+    }
+    for (size_t index = 0; index < config.guilds; index++) {
+        world.guilds.push_back(std::make_unique<Guild>(RemovalPolicy::UNORDERED));
+        world.inboxes.push_back(std::make_unique<GuildInbox>());
+        Worker& owner = *workers[index % config.threads];
+        owner.owned.push_back(index);
+        std::vector<Player> players;
+        players.reserve(config.players);
+        for (size_t i = 0; i < config.players; i++) {
+            players.emplace_back("w" + std::to_string(owner.id) + "-p" + std::to_string(owner.nextPlayer++),
+                                 randomLoadout(owner.rng));
+        }
+        world.guilds.back()->enlistPlayers(players);
+        world.sizes[index].store(config.players);
+    }
+
+    std::cout << "guilds " << config.guilds << ", players " << config.guilds * config.players
+              << ", threads " << config.threads << ", rate " << (config.rate > 0 ? std::to_string(config.rate) : "max")
+              << "\nelapsed_s, operations, rss_mib\n" << std::fixed << std::setprecision(1);
+
+    Clock::time_point begin = Clock::now();
+    Clock::time_point deadline = begin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.seconds));
+    std::vector<std::thread> threads;
+    for (auto& worker : workers) {
+        threads.emplace_back(runWorker, std::ref(*worker), std::ref(world), std::cref(config), deadline);
+    }
+
+    // Sample RSS until the workers pass the deadline
+    auto reportEvery = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.report));
+    for (Clock::time_point next = begin + reportEvery; next < deadline + reportEvery; next += reportEvery) {
+        std::this_thread::sleep_until(std::min(next, deadline));
+        std::uint64_t operations = 0;
+        for (const auto& worker : workers) { operations += worker->operations.load(std::memory_order_relaxed); }
+        std::cout << std::chrono::duration<double>(Clock::now() - begin).count() << ", " << operations << ", "
+                  << static_cast<double>(residentKiB()) / 1024 << "\n";
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    // Every thread has stopped, so this one may drain every guild's inbox
+    size_t members = 0;
+    for (size_t index = 0; index < config.guilds; index++) {
+        world.inboxes[index]->drain(*world.guilds[index], SIZE_MAX);
+        members += world.guilds[index]->getPlayerCount();
+    }
+
+    std::array<LatencyHistogram, OPERATION_COUNT> latencies;
+    std::uint64_t late = 0;
+    for (const auto& worker : workers) {
+        for (size_t op = 0; op < OPERATION_COUNT; op++) { latencies[op].merge(worker->latencies[op]); }
+        late += worker->latePasses.load();
+    }
+    std::cout << "\noperation, count, p50_us, p99_us, p999_us, max_us\n" << std::setprecision(2);
+    for (size_t op = 0; op < OPERATION_COUNT; op++) {
+        const LatencyHistogram& histogram = latencies[op];
+        std::cout << OPERATION_NAMES[op] << ", " << histogram.total << ", " << histogram.percentile(0.5) / 1e3 << ", "
+                  << histogram.percentile(0.99) / 1e3 << ", " << histogram.percentile(0.999) / 1e3 << ", "
+                  << histogram.max / 1e3 << "\n";
+    }
+    if (config.rate > 0) { std::cout << "operations started behind schedule: " << late << "\n"; }
+    std::cout << "members at end " << members << ", rss growth "
+              << (static_cast<double>(residentKiB()) - static_cast<double>(startRss)) / 1024 << " MiB\n";
+
+    world.inboxes.clear();
+    world.guilds.clear();
+    return reportLeaks(before) ? 0 : 2;
+}
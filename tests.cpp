@@ -0,0 +1,1161 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ConcurrentGuild.hpp"
+#include "FixedInventory.hpp"
+#include "Guild.hpp"
+#include "GuildInbox.hpp"
+#include "Instrumentation.hpp"
+#include "Inventory.hpp"
+#include "InventoryColumns.hpp"
+#include "ItemPool.hpp"
+#include "MappedRoster.hpp"
+#include "NameTable.hpp"
+#include "Player.hpp"
+#include "PlayerCodec.hpp"
+#include "RosterStream.hpp"
+#include "SnapshotInventory.hpp"
+
+// Regression checks for the invariants the walkthrough in main.cpp does not cover.
+// `make test` builds and runs them; the exit status is non-zero if any check failed.
+
+static int failures = 0;
+
+/**
+ * @brief Reports one check and counts it if it failed.
+ * @param passed The outcome of the check.
+ * @param what A short description of what was checked.
+ */
+static void check(bool passed, const char* what) {
+    std::cout << (passed ? "PASS: " : "FAIL: ") << what << "\n";
+    if (!passed) { failures++; }
+}
+
+/**
+ * @brief Encodes a player and decodes the record again.
+ * @return The decoded player, or std::nullopt (after reporting a failed check) if decoding threw.
+ */
+static std::optional<Player> roundTrip(const Player& player) {
+    try {
+        return PlayerCodec::decode(PlayerCodec::encode(player));
+    } catch (const std::exception& error) {
+        check(false, error.what());
+        return std::nullopt;
+    }
+}
+
+/**
+ * @brief Tests that PlayerCodec records decode back to the player they were encoded from.
+ */
+void testCodecRoundTrip() {
+    std::cout << "\n==== TESTING CODEC ROUND TRIP ====\n";
+
+    Inventory bag(2, 2, std::vector<Item>(4), new Item("Shield", 5.0, ARMOR));
+    bag.store(0, 0, Item("Excalibur", 10.5, WEAPON));
+    bag.store(0, 1, Item()); // Storing an empty item must leave the cell, and the count, empty
+    check(bag.getCount() == 1, "storing a NONE item is not counted");
+
+    std::optional<Player> decoded = roundTrip(Player("Arthur", bag));
+    if (decoded) {
+        const Inventory& inventory = decoded->getInventoryRef();
+        check(decoded->getName() == "Arthur", "round trip keeps the name");
+        check(inventory.getCount() == 1 && inventory.getWeight() == 10.5f, "round trip keeps the totals");
+        check(inventory.at(0, 0).name_ == "Excalibur" && inventory.at(0, 1).type_ == NONE, "round trip keeps the cells");
+        check(inventory.getEquipped() && inventory.getEquipped()->name_ == "Shield", "round trip keeps the equipped item");
+    }
+
+    auto placements = bag.storeMany({Item(), Item("Elixir", 0.5, ACCESSORY)});
+    check(bag.getCount() == 2, "storeMany does not count NONE items");
+    check(!placements[0] && placements[1] == std::make_pair(size_t{0}, size_t{1}),
+          "storeMany places nothing for a NONE item and leaves its cell to the next pickup");
+    decoded = roundTrip(Player("Arthur", bag));
+    check(decoded && decoded->getInventoryRef().getCount() == 2, "round trip after storeMany with a NONE item");
+}
+
+/**
+ * @brief Checks that decoding a record throws std::invalid_argument.
+ * @param bytes The record to decode, both as a Player and through a RecordView.
+ * @param what A short description of what is wrong with the record.
+ */
+static void checkRejected(const std::vector<std::uint8_t>& bytes, const char* what) {
+    bool decodeThrew = false;
+    bool viewThrew = false;
+    try { PlayerCodec::decode(bytes); } catch (const std::invalid_argument&) { decodeThrew = true; }
+    try { PlayerCodec::RecordView(bytes.data(), bytes.size()); } catch (const std::invalid_argument&) { viewThrew = true; }
+    check(decodeThrew && viewThrew, what);
+}
+
+/**
+ * @brief Tests that malformed PlayerCodec headers are rejected before anything is allocated.
+ */
+void testCodecRejectsBadHeaders() {
+    std::cout << "\n==== TESTING CODEC HEADER VALIDATION ====\n";
+
+    std::vector<std::uint8_t> record = PlayerCodec::encode(Player("Arthur", Inventory(1, 1, std::vector<Item>(1))));
+    // Patches a little-endian u32 header field; rows, cols and the item count follow the 8-byte preamble
+    auto patch = [](std::vector<std::uint8_t> bytes, size_t offset, std::uint32_t value) {
+        for (size_t i = 0; i < 4; i++) { bytes[offset + i] = static_cast<std::uint8_t>(value >> (8 * i)); }
+        return bytes;
+    };
+    checkRejected(patch(patch(record, 8, 0x7fffffff), 12, 0), "huge rows with zero cols");
+    checkRejected(patch(patch(record, 8, 0), 12, 0x7fffffff), "zero rows with huge cols");
+    checkRejected(patch(record, 16, 2), "more items than cells");
+
+    bool threw = false;
+    try { PlayerCodec::encode(Player("Arthur", Inventory(3, 0, std::vector<Item>()))); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw, "encoding a 3x0 inventory throws");
+}
+
+/**
+ * @brief Tests that demoting idle players never leaves one unreachable.
+ */
+void testDemotion() {
+    std::cout << "\n==== TESTING DEMOTION ====\n";
+
+    Guild guild;
+    Player fine("Fine", Inventory(1, 1, std::vector<Item>{Item("Elixir", 0.5, ACCESSORY)}));
+    Player odd("Odd", Inventory(3, 0, std::vector<Item>())); // No PlayerCodec record can hold a 3x0 grid
+    guild.enlistPlayer(fine);
+    guild.enlistPlayer(odd);
+    guild.setTieringPolicy(TieringPolicy{0, 0});
+    guild.findPlayer("Nobody"); // Advances the access clock, so both players are idle
+
+    check(guild.demoteIdlePlayers() == 1, "only the encodable player is demoted");
+    check(guild.getTieringStats().failed_demotions == 1, "the failed demotion is counted");
+    check(guild.findPlayer("Odd") != guild.getPlayers().end(), "the player kept hot is still reachable");
+    auto rehydrated = guild.findPlayer("Fine");
+    check(rehydrated != guild.getPlayers().end() && rehydrated->getInventoryRef().getCount() == 1,
+          "the demoted player rehydrates intact");
+}
+
+/**
+ * @brief Lists the enlisted players' names as getPlayersByJoinTime() orders them, e.g. "a b c".
+ */
+static std::string joinOrder(Guild& guild) {
+    std::string names;
+    for (auto playerItr : guild.getPlayersByJoinTime()) { names += (names.empty() ? "" : " ") + playerItr->getName(); }
+    return names;
+}
+
+/**
+ * @brief Tests that rehydration and policy switches keep join order.
+ */
+void testJoinOrder() {
+    std::cout << "\n==== TESTING JOIN ORDER ====\n";
+
+    Guild guild;
+    for (const char* name : {"a", "b", "c"}) {
+        Player player(name);
+        guild.enlistPlayer(player);
+    }
+    guild.setTieringPolicy(TieringPolicy{1, 0});
+    guild.findPlayer("b");
+    guild.findPlayer("c"); // "a" is now idle for two accesses, "b" for one
+    check(guild.demoteIdlePlayers() == 1 && guild.getColdPlayerCount() == 1, "only the idle player is demoted");
+    guild.findPlayer("a");
+    check(joinOrder(guild) == "a b c", "a rehydrated player keeps their join order under STABLE");
+    check(guild.getPlayers().front().getName() == "a", "enlisted_players stays in join order under STABLE");
+
+    Guild swapping(RemovalPolicy::UNORDERED);
+    for (const char* name : {"a", "b", "c", "d"}) {
+        Player player(name);
+        swapping.enlistPlayer(player);
+    }
+    swapping.releasePlayer("a"); // Swaps "d" into the first slot
+    check(joinOrder(swapping) == "b c d", "UNORDERED recovers join order");
+    swapping.setRemovalPolicy(RemovalPolicy::STABLE);
+    check(swapping.getPlayers().front().getName() == "b" && joinOrder(swapping) == "b c d",
+          "switching back to STABLE restores join order");
+
+    Guild indexed(RemovalPolicy::JOIN_ORDER);
+    for (const char* name : {"a", "b", "c", "d"}) {
+        Player player(name);
+        indexed.enlistPlayer(player);
+    }
+    indexed.releasePlayer("a");
+    check(indexed.getPlayers().front().getName() == "d", "JOIN_ORDER removes by swap and pop");
+    check(joinOrder(indexed) == "b c d", "JOIN_ORDER walks its join index");
+    indexed.setRemovalPolicy(RemovalPolicy::UNORDERED);
+    Player late("e");
+    indexed.enlistPlayer(late);
+    indexed.releasePlayer("c");
+    indexed.setRemovalPolicy(RemovalPolicy::JOIN_ORDER);
+    check(joinOrder(indexed) == "b d e", "switching to JOIN_ORDER builds its join index");
+}
+
+/**
+ * @brief Tests that a run of small batches still grows enlisted_players geometrically.
+ */
+void testBatchGrowth() {
+    std::cout << "\n==== TESTING BATCH GROWTH ====\n";
+
+    Guild guild;
+    size_t reallocations = 0;
+    size_t capacity = guild.getPlayers().capacity();
+    for (int i = 0; i < 1000; i++) {
+        std::vector<Player> batch{Player("p" + std::to_string(i))};
+        guild.enlistPlayers(batch);
+        if (guild.getPlayers().capacity() != capacity) {
+            capacity = guild.getPlayers().capacity();
+            reallocations++;
+        }
+    }
+    check(guild.getPlayers().size() == 1000, "every batch is enlisted");
+    check(reallocations <= 20, "1000 one-player batches reallocate a logarithmic number of times");
+}
+
+/**
+ * @brief Tests that blocks freed on a consumer thread flow back to the thread allocating them.
+ */
+void testItemPoolCrossThread() {
+    std::cout << "\n==== TESTING ITEM POOL ACROSS THREADS ====\n";
+
+    constexpr int ROUNDS = 2000;
+    constexpr int BATCH = 64;
+    std::mutex mutex;
+    std::condition_variable handoff;
+    std::vector<void*> batch;
+    bool done = false;
+    ItemPool::Stats consumerStats{};
+
+    // Frees every batch the producer hands over, on its own pool
+    std::thread consumer([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            handoff.wait(lock, [&] { return done || !batch.empty(); });
+            if (batch.empty()) { break; }
+            for (void* block : batch) { ItemPool::local().deallocate(block); }
+            batch.clear();
+            handoff.notify_all();
+        }
+        consumerStats = ItemPool::local().getStats();
+    });
+
+    ItemPool& producer = ItemPool::local();
+    ItemPool::Stats before = producer.getStats();
+    for (int round = 0; round < ROUNDS; round++) {
+        std::vector<void*> blocks;
+        for (int i = 0; i < BATCH; i++) { blocks.push_back(producer.allocate()); }
+        std::unique_lock<std::mutex> lock(mutex);
+        batch = std::move(blocks);
+        handoff.notify_all();
+        handoff.wait(lock, [&] { return batch.empty(); });
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    handoff.notify_all();
+    consumer.join();
+    ItemPool::Stats after = producer.getStats();
+
+    check(consumerStats.deallocations == after.allocations - before.allocations,
+          "every block allocated on the producer is freed on the consumer");
+    check(after.slab_allocations - before.slab_allocations <= 8,
+          "one-way traffic reuses a bounded number of slabs");
+}
+
+/**
+ * @brief Tests that a Snapshot keeps its version while writers publish newer ones.
+ */
+void testSnapshots() {
+    std::cout << "\n==== TESTING SNAPSHOTS ====\n";
+
+    // The pin belongs to the reading thread, so a Snapshot must not be handed to another one
+    static_assert(!std::is_move_constructible<SnapshotInventory::Snapshot>::value, "Snapshot is thread-affine");
+
+    SnapshotInventory shared(Inventory(1, 2, std::vector<Item>(2)));
+    auto before = shared.read();
+    shared.store(0, 0, Item("Excalibur", 10.5, WEAPON));
+    {
+        auto nested = shared.read();
+        check(nested->getCount() == 1, "a new snapshot sees the latest version");
+    }
+    shared.store(0, 1, Item("Elixir", 0.5, ACCESSORY)); // Reclaims nothing while `before` is pinned
+    check(before->getCount() == 0 && before->at(0, 0).type_ == NONE, "an older snapshot keeps its version");
+}
+
+/**
+ * @brief Tests that InventoryColumns stores its cells as PackedItems that unpack to the original Items.
+ */
+void testPackedCells() {
+    std::cout << "\n==== TESTING PACKED CELLS ====\n";
+
+    NameTable names;
+    Inventory bag(1, 2, std::vector<Item>{Item("Excalibur", 10.5, WEAPON), Item()});
+    InventoryColumns columns(bag, names);
+    check(columns.getCell(0, 0) == names.pack(bag.at(0, 0)), "a column cell matches the packed Item");
+    check(columns.getItem(0, 0) == bag.at(0, 0) && columns.getItem(0, 1) == bag.at(0, 1),
+          "column cells unpack to the original Items");
+
+    bool threw = false;
+    try { columns.getCell(1, 0); } catch (const std::out_of_range&) { threw = true; }
+    check(threw, "reading a cell outside the grid throws");
+}
+
+/**
+ * @brief Tests that take, moveCell and swapCells report exactly the cells they wrote to drainChanges().
+ */
+void testChangeTracking() {
+    std::cout << "\n==== TESTING CHANGE TRACKING ====\n";
+
+    using Cells = std::vector<std::pair<size_t, size_t>>;
+    Inventory bag; // 10x10, so the cells below span two bitset words
+    bag.store(0, 0, Item("Excalibur", 10.5, WEAPON));
+    bag.store(0, 1, Item("Elixir", 0.5, ACCESSORY));
+    bag.drainChanges();
+
+    check(bag.take(0, 0).name_ == "Excalibur" && bag.drainChanges().cells == Cells{{0, 0}}, "take marks its cell");
+    bag.take(0, 0);
+    check(!bag.hasChanges(), "taking from an empty cell marks nothing");
+
+    check(bag.moveCell(0, 1, 9, 9) && bag.drainChanges().cells == Cells{{0, 1}, {9, 9}}, "moveCell marks both cells");
+    check(!bag.moveCell(0, 1, 5, 5) && !bag.hasChanges(), "a failed moveCell marks nothing");
+
+    bag.swapCells(9, 9, 0, 1);
+    InventoryChanges swapped = bag.drainChanges();
+    check(swapped.cells == Cells{{0, 1}, {9, 9}} && !swapped.equipped, "swapCells marks both cells in row-major order");
+    bag.swapCells(0, 1, 0, 1);
+    check(!bag.hasChanges(), "swapping a cell with itself marks nothing");
+    check(bag.drainChanges().cells.empty(), "a second drain finds nothing");
+}
+
+/**
+ * @brief A memory resource that throws std::bad_alloc for large requests while armed.
+ */
+class FailingResource : public std::pmr::memory_resource {
+    public:
+        bool armed = false;
+        size_t limit = 1024; // Requests at least this large fail while armed
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            if (armed && bytes >= limit) { throw std::bad_alloc(); }
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+/**
+ * @brief Tests that a failed append leaves the player and both guilds unchanged.
+ */
+void testFailedAppend() {
+    std::cout << "\n==== TESTING FAILED APPENDS ====\n";
+
+    FailingResource failing;
+    Guild guild(RemovalPolicy::JOIN_ORDER, &failing);
+    std::vector<Player> batch;
+    for (const char* name : {"a", "b", "c", "d"}) { batch.emplace_back(name); }
+    guild.enlistPlayers(batch);
+    // No spare room, so the next append reallocates and (like rehoming an inventory) allocates a large block
+    check(guild.getPlayers().size() == guild.getPlayers().capacity(), "the roster is full");
+
+    failing.armed = true;
+    Player late("e");
+    bool threw = false;
+    try { guild.enlistPlayer(late); } catch (const std::bad_alloc&) { threw = true; }
+    check(threw && !guild.hasPlayer("e") && late.getName() == "e", "a failed enlist leaves the player out");
+    check(late.getInventoryRef().getRows() == 10, "a failed enlist leaves the player's inventory intact");
+    check(guild.findPlayer("e") == guild.getPlayers().end() && joinOrder(guild) == "a b c d",
+          "a failed enlist leaves the roster and join index unchanged");
+
+    Guild source;
+    Player moving("m");
+    source.enlistPlayer(moving);
+    threw = false;
+    try { source.movePlayerTo("m", guild); } catch (const std::bad_alloc&) { threw = true; }
+    check(threw && !guild.hasPlayer("m") && source.hasPlayer("m"), "a failed move leaves both guilds unchanged");
+    threw = false;
+    try { source.copyPlayerTo("m", guild); } catch (const std::bad_alloc&) { threw = true; }
+    check(threw && !guild.hasPlayer("m"), "a failed copy leaves the target unchanged");
+
+    failing.armed = false;
+    check(guild.enlistPlayer(late) && joinOrder(guild) == "a b c d e", "the guild accepts the player afterwards");
+}
+
+/**
+ * @brief Tests that move assignment never moves an Inventory off its memory resource.
+ */
+void testArenaAssignment() {
+    std::cout << "\n==== TESTING ARENA ASSIGNMENT ====\n";
+
+    std::pmr::monotonic_buffer_resource home;
+    std::pmr::memory_resource* homeResource = &home;
+    Inventory target(1, 2, std::vector<Item>(2), nullptr, &home);
+    {
+        std::pmr::monotonic_buffer_resource away;
+        Inventory source(1, 2, std::vector<Item>{Item("Excalibur", 10.5, WEAPON), Item()}, new Item("Shield", 5.0, ARMOR),
+                         &away);
+        target = std::move(source);
+        check(target.get_allocator().resource() == homeResource, "move assignment keeps the target's resource");
+        check(source.getCount() == 0 && source.getRows() == 0, "the source is left empty");
+    } // Releases every block of the other arena
+    check(target.at(0, 0).name_ == "Excalibur" && target.getCount() == 1 && target.getEquipped()->name_ == "Shield",
+          "the contents outlive the arena they came from");
+
+    Inventory sibling(1, 1, std::vector<Item>{Item("Elixir", 0.5, ACCESSORY)}, nullptr, &home);
+    target = std::move(sibling);
+    check(target.get_allocator().resource() == homeResource && target.getCount() == 1,
+          "move assignment on one resource takes the storage over");
+
+    // A cold player decodes onto the default resource and is assigned back into its arena slot
+    Guild guild(RemovalPolicy::STABLE, &home);
+    for (const char* name : {"a", "b", "c"}) {
+        Player player(name);
+        guild.enlistPlayer(player);
+    }
+    guild.setTieringPolicy(TieringPolicy{1, 0});
+    guild.findPlayer("b");
+    guild.findPlayer("c");
+    guild.demoteIdlePlayers();
+    guild.findPlayer("a");
+    bool allHome = true;
+    for (const Player& player : guild.getPlayers()) { allHome = allHome && player.get_allocator().resource() == homeResource; }
+    check(joinOrder(guild) == "a b c" && allHome, "a rehydrated player lives on the guild's resource");
+}
+
+/**
+ * @brief Tests that a copy starts a checkpoint of its own while a move keeps the pending changes.
+ */
+void testCopiedChanges() {
+    std::cout << "\n==== TESTING CHANGES OF COPIES ====\n";
+
+    using Cells = std::vector<std::pair<size_t, size_t>>;
+    Inventory bag;
+    bag.store(0, 0, Item("Excalibur", 10.5, WEAPON));
+    bag.equip(new Item("Shield", 5.0, ARMOR));
+
+    Inventory copy(bag);
+    check(!copy.hasChanges() && copy.drainChanges().cells.empty(), "a copy has no pending changes");
+    copy.store(0, 1, Item("Elixir", 0.5, ACCESSORY));
+    check(copy.drainChanges().cells == Cells{{0, 1}}, "a copy reports only its own writes");
+    Inventory assigned;
+    assigned = bag;
+    check(!assigned.hasChanges(), "copy assignment starts a new checkpoint");
+
+    InventoryChanges pending = bag.drainChanges();
+    check(pending.cells == Cells{{0, 0}} && pending.equipped, "the source keeps its pending changes");
+    bag.store(9, 9, Item("Elixir", 0.5, ACCESSORY));
+    Inventory moved(std::move(bag));
+    check(moved.drainChanges().cells == Cells{{9, 9}}, "a move carries the pending changes");
+
+    Guild source;
+    Guild target;
+    Player player("Arthur");
+    player.getInventoryRef().store(0, 0, Item("Excalibur", 10.5, WEAPON));
+    source.enlistPlayer(player);
+    source.copyPlayerTo("Arthur", target);
+    check(!target.findPlayer("Arthur")->getInventoryRef().hasChanges(), "a player copied to another guild has no pending changes");
+}
+
+/**
+ * @brief Tests that a drain that throws still completes every transfer it took.
+ */
+void testInboxFailure() {
+    std::cout << "\n==== TESTING INBOX FAILURES ====\n";
+
+    FailingResource failing;
+    Guild guild(RemovalPolicy::STABLE, &failing);
+    GuildInbox inbox;
+    // "a" already lives on the guild's resource, so enlisting them never allocates a grid
+    std::future<TransferOutcome> a = inbox.post(Player("a", Inventory(1, 1, std::vector<Item>(1), nullptr, &failing)));
+    std::future<TransferOutcome> b = inbox.post(Player("b"));
+    std::future<TransferOutcome> c = inbox.post(Player("c"));
+
+    failing.armed = true; // Rehoming the 10x10 grids of "b" and "c" fails
+    bool threw = false;
+    try { inbox.drain(guild); } catch (const std::bad_alloc&) { threw = true; }
+    failing.armed = false;
+    check(threw, "the drain rethrows");
+    check(a.wait_for(std::chrono::seconds(0)) == std::future_status::ready && a.get().accepted && guild.hasPlayer("a"),
+          "a transfer enlisted before the failure is accepted");
+    bool handedBack = true;
+    for (std::future<TransferOutcome>* outcome : {&b, &c}) {
+        handedBack = handedBack && outcome->wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        TransferOutcome result = outcome->get();
+        handedBack = handedBack && !result.accepted && result.returned && result.returned->getInventoryRef().getRows() == 10;
+    }
+    check(handedBack && !guild.hasPlayer("b") && !guild.hasPlayer("c"), "the other transfers are handed back intact");
+}
+
+/**
+ * @brief Checks ConcurrentGuild under contention: opposing cross-guild moves, moves into the same guild,
+ * copies and enlistments from several threads, then the final roster. Run it under -fsanitize=thread too.
+ */
+void testConcurrentGuild() {
+    std::cout << "\n==== TESTING CONCURRENT GUILD ====\n";
+
+    constexpr int THREADS = 4;
+    constexpr int ROUNDS = 2000;
+    constexpr int WANDERERS = 64;
+    // Different shard counts, so a name usually lands in a different shard index on each side
+    ConcurrentGuild east(4);
+    ConcurrentGuild west(3);
+    ConcurrentGuild archive(2);
+    for (int i = 0; i < WANDERERS; i++) {
+        Player wanderer("Wanderer" + std::to_string(i), Inventory(2, 2, std::vector<Item>(4, Item("Map", 0.1, ACCESSORY))));
+        east.enlistPlayer(wanderer);
+    }
+
+    std::atomic<int> recruits{0};
+    std::atomic<int> copies{0};
+    std::atomic<bool> selfMoved{false};
+    std::atomic<bool> recruitRejected{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; t++) {
+        workers.emplace_back([&, t] {
+            std::mt19937 random(t + 1);
+            for (int round = 0; round < ROUNDS; round++) {
+                std::string name = "Wanderer" + std::to_string(random() % WANDERERS);
+                // Odd threads mostly push west and even threads east, so transfers oppose each other
+                bool westward = (random() % 4 != 0) == (t % 2 == 1);
+                ConcurrentGuild& from = westward ? east : west;
+                ConcurrentGuild& to = westward ? west : east;
+                switch (random() % 4) {
+                    case 0:
+                    case 1:
+                        from.movePlayerTo(name, to);
+                        break;
+                    case 2:
+                        if (from.movePlayerTo(name, from)) { selfMoved = true; }
+                        if (from.copyPlayerTo(name, archive)) { copies++; }
+                        break;
+                    default: {
+                        Player recruit("Recruit" + std::to_string(t) + "_" + std::to_string(round));
+                        if (to.enlistPlayer(recruit)) { recruits++; } else { recruitRejected = true; }
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) { worker.join(); }
+
+    bool everyWandererOnce = true;
+    bool archivedOnce = true;
+    int archived = 0;
+    for (int i = 0; i < WANDERERS; i++) {
+        std::string name = "Wanderer" + std::to_string(i);
+        everyWandererOnce = everyWandererOnce && (east.hasPlayer(name) != west.hasPlayer(name));
+        if (archive.hasPlayer(name)) {
+            archived++;
+            archive.withPlayer(name, [&](const Player& player) {
+                archivedOnce = archivedOnce && player.getInventoryRef().getRows() == 2;
+            });
+        }
+    }
+    check(!selfMoved, "a move into the same guild is refused");
+    check(!recruitRejected, "every fresh recruit is enlisted");
+    check(everyWandererOnce, "every wanderer ends in exactly one of the two guilds");
+    check(east.getPlayerCount() + west.getPlayerCount() == size_t(WANDERERS + recruits),
+        "the two guilds hold every wanderer and recruit, with no losses or duplicates");
+    check(archived == copies && archive.getPlayerCount() == size_t(copies),
+        "each successful copy archived a distinct wanderer");
+    check(archivedOnce, "archived copies keep their inventories");
+}
+
+/**
+ * @brief Writes raw bytes to a file, replacing it.
+ */
+static void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+}
+
+/**
+ * @brief Checks MappedRoster: writing and reopening a roster, rejecting damaged files,
+ * and writing back a guild whose mapped records were partly claimed.
+ */
+void testMappedRoster() {
+    std::cout << "\n==== TESTING MAPPED ROSTERS ====\n";
+
+    const std::string path = (std::filesystem::temp_directory_path() / "mmorpg_tests.roster").string();
+    const std::string damaged = path + ".damaged";
+    const std::string rewritten = path + ".rewritten";
+    Guild guild;
+    for (const char* name : {"Cedric", "Arthur", "Bors"}) {
+        Player player(name, Inventory(2, 3, std::vector<Item>(6, Item(std::string(name) + "'s Ration", 0.5, ACCESSORY)),
+            new Item("Kite Shield", 6.0, ARMOR)));
+        guild.enlistPlayer(player);
+    }
+    MappedRoster::write(guild, path);
+
+    {
+        MappedRoster roster(path);
+        std::optional<size_t> slot = roster.find("Bors");
+        check(roster.getSize() == 3 && roster.find("Arthur") == size_t(0) && slot == size_t(1),
+            "a written roster reopens with its index sorted by name");
+        check(!roster.find("Nobody") && !roster.find(""), "absent names are not found");
+        PlayerCodec::RecordView record = roster.getRecord(*slot);
+        Player bors = record.materialize();
+        check(record.getName() == "Bors" && record.getCount() == 6 && record.getEquipped()
+            && bors.getInventoryRef().getItems() == guild.findPlayer("Bors")->getInventoryRef().getItems(),
+            "a reopened record views and decodes to the written player");
+        bool threw = false;
+        try { roster.getRecord(3); } catch (const std::out_of_range&) { threw = true; }
+        check(threw, "a slot past the index is rejected");
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    bool threw = false;
+    // Keep the header and one of the three index entries
+    writeBytes(damaged, std::vector<char>(bytes.begin(), bytes.begin() + 32));
+    try { MappedRoster roster(damaged); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw, "a roster whose index is truncated is rejected");
+
+    std::vector<char> corrupt = bytes;
+    corrupt[16 + 16 + 7] = char(0x40); // The second entry's offset now points far past the file
+    writeBytes(damaged, corrupt);
+    {
+        MappedRoster roster(damaged);
+        threw = false;
+        try { roster.getRecord(1); } catch (const std::invalid_argument&) { threw = true; }
+        check(threw && roster.getRecord(0).getName() == "Arthur",
+            "a corrupt index entry is rejected without affecting the others");
+    }
+
+    std::vector<char> foreign = bytes;
+    foreign[0] = 'X';
+    writeBytes(damaged, foreign);
+    threw = false;
+    try { MappedRoster roster(damaged); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw, "a file without the roster magic is rejected");
+
+    Guild mapped;
+    mapped.attachRoster(std::make_shared<const MappedRoster>(path));
+    auto bors = mapped.findPlayer("Bors"); // Claims the mapped record
+    bors->getInventoryRef().take(0, 0);
+    check(mapped.getMappedPlayerCount() == 2 && mapped.getPlayerCount() == 3, "materializing claims one mapped record");
+    MappedRoster::write(mapped, rewritten);
+    {
+        MappedRoster original(path);
+        MappedRoster roster(rewritten);
+        PlayerCodec::RecordView arthur = roster.getRecord(0);
+        PlayerCodec::RecordView before = original.getRecord(0);
+        check(roster.getSize() == 3 && roster.getRecord(1).getName() == "Bors" && roster.getRecord(1).getCount() == 5,
+            "a claimed player is written once, with their changes");
+        check(arthur.getSize() == before.getSize()
+            && std::equal(arthur.getData(), arthur.getData() + arthur.getSize(), before.getData()),
+            "unclaimed mapped records are copied over byte for byte");
+    }
+
+    std::remove(path.c_str());
+    std::remove(damaged.c_str());
+    std::remove(rewritten.c_str());
+}
+
+/**
+ * @brief A stream buffer that accepts a fixed number of bytes and then fails every write.
+ */
+class LimitedBuffer : public std::streambuf {
+    public:
+        size_t room;
+
+        explicit LimitedBuffer(size_t room) : room(room) {}
+    protected:
+        int_type overflow(int_type c) override {
+            if (room == 0 || traits_type::eq_int_type(c, traits_type::eof())) { return traits_type::eof(); }
+            room--;
+            return c;
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override {
+            std::streamsize accepted = std::min<std::streamsize>(count, static_cast<std::streamsize>(room));
+            room -= static_cast<size_t>(accepted);
+            return accepted;
+        }
+};
+
+/**
+ * @brief Finds where the i-th length-prefixed record of a roster stream starts.
+ * @return The offset of the record's length prefix.
+ */
+static size_t streamRecordOffset(const std::string& stream, size_t index) {
+    size_t offset = 8; // Past the stream header
+    for (size_t i = 0; i < index; i++) {
+        std::uint32_t size = 0;
+        for (unsigned byte = 0; byte < 4; byte++) { size |= std::uint32_t(std::uint8_t(stream[offset + byte])) << (byte * 8); }
+        offset += 4 + size;
+    }
+    return offset;
+}
+
+/**
+ * @brief Checks RosterStream: a chunked export/import round trip, and that a failing stage
+ * on either side stops the pipeline with its exception and keeps the chunks already handed over.
+ */
+void testRosterStream() {
+    std::cout << "\n==== TESTING ROSTER STREAMS ====\n";
+
+    constexpr size_t PLAYERS = 10;
+    constexpr size_t CHUNK = 3;
+    Guild source;
+    for (size_t i = 0; i < PLAYERS; i++) {
+        Player recruit("Recruit" + std::to_string(i), Inventory(1, i + 1, std::vector<Item>(i + 1, Item("Arrow", 0.1, WEAPON))));
+        source.enlistPlayer(recruit);
+    }
+    source.setTieringPolicy(TieringPolicy{0, PLAYERS / 2});
+    source.findPlayer("Nobody");
+    source.demoteIdlePlayers(); // Half the roster is exported from the cold store
+
+    std::stringstream stream;
+    check(source.getColdPlayerCount() == PLAYERS / 2 && RosterStream::exportGuild(source, stream, CHUNK) == PLAYERS,
+        "every enlisted and cold player is exported");
+    const std::string exported = stream.str();
+    Guild imported;
+    bool intact = RosterStream::importGuild(stream, imported, CHUNK) == PLAYERS && imported.getPlayerCount() == PLAYERS;
+    for (size_t i = 0; i < PLAYERS; i++) {
+        auto playerItr = imported.findPlayer("Recruit" + std::to_string(i));
+        intact = intact && playerItr != imported.getPlayers().end() && playerItr->getInventoryRef().getCount() == i + 1;
+    }
+    check(intact, "a roster larger than the chunk size round-trips");
+
+    Guild resident;
+    Player veteran("Recruit4", Inventory(1, 1, std::vector<Item>(1, Item("Longbow", 2.0, WEAPON))));
+    resident.enlistPlayer(veteran);
+    std::stringstream again(exported);
+    check(RosterStream::importGuild(again, resident, CHUNK) == PLAYERS - 1 && resident.getPlayerCount() == PLAYERS
+        && resident.findPlayer("Recruit4")->getInventoryRef().getCount() == 1,
+        "players already in the guild are skipped and left as they were");
+
+    // The eighth record lies in the third chunk, so the first two are enlisted before the producer throws
+    std::string malformed = exported;
+    malformed[streamRecordOffset(exported, 7) + 4] ^= 0x5A;
+    std::stringstream bad(malformed);
+    Guild partial;
+    bool threw = false;
+    try { RosterStream::importGuild(bad, partial, CHUNK); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw && partial.getPlayerCount() == 2 * CHUNK, "a malformed record stops the import after the earlier chunks");
+
+    std::stringstream truncated(exported.substr(0, exported.size() - 2));
+    Guild cut;
+    threw = false;
+    try { RosterStream::importGuild(truncated, cut, CHUNK); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw && cut.getPlayerCount() == PLAYERS - PLAYERS % CHUNK,
+        "a stream missing its end marker is rejected, losing only the unfinished last chunk");
+
+    // Room for the header and part of the first chunk, so the consumer fails while the producer is still running
+    LimitedBuffer buffer(12);
+    std::ostream failing(&buffer);
+    threw = false;
+    try { RosterStream::exportGuild(source, failing, CHUNK); } catch (const std::ios_base::failure&) { threw = true; }
+    check(threw, "a failing output stream stops the export");
+}
+
+/**
+ * @brief Checks that an indexed guild answers item and weight queries as an unindexed twin does.
+ */
+static void checkQueriesAgree(Guild& indexed, Guild& scanned, const char* what) {
+    bool agree = indexed.hasIndexes() && !scanned.hasIndexes();
+    for (const char* item : {"Sword", "Herb", "Shield", "Nothing"}) {
+        agree = agree && indexed.findPlayersCarrying(item) == scanned.findPlayersCarrying(item);
+    }
+    for (float weight : {-1.0f, 1.0f, 4.0f, 9.0f, 100.0f}) {
+        agree = agree && indexed.findPlayersHeavierThan(weight) == scanned.findPlayersHeavierThan(weight);
+    }
+    check(agree, what);
+}
+
+/**
+ * @brief Checks that the indexed and scanning paths of findPlayersCarrying() and
+ * findPlayersHeavierThan() agree after every kind of roster change.
+ */
+void testIndexedQueries() {
+    std::cout << "\n==== TESTING INDEXED QUERIES ====\n";
+
+    Guild indexed;
+    Guild scanned;
+    Guild indexedSide;
+    Guild scannedSide;
+    indexed.enableIndexes();
+    indexedSide.enableIndexes();
+    // Runs one change on both twins
+    auto onBoth = [&](auto change) {
+        change(indexed, indexedSide);
+        change(scanned, scannedSide);
+    };
+
+    onBoth([](Guild& guild, Guild&) {
+        for (int i = 0; i < 6; i++) {
+            Player player("Hero" + std::to_string(i), Inventory(2, 2, std::vector<Item>{
+                Item(i % 2 ? "Sword" : "Herb", 1.0f + i, i % 2 ? WEAPON : ACCESSORY),
+                Item("Herb", 0.5f, ACCESSORY), Item("Rope", 2.0f, ACCESSORY), Item()},
+                i % 3 == 0 ? new Item("Shield", 4.0f, ARMOR) : nullptr));
+            guild.enlistPlayer(player);
+        }
+    });
+    checkQueriesAgree(indexed, scanned, "queries agree after enlisting");
+
+    onBoth([](Guild& guild, Guild& side) { guild.movePlayerTo("Hero1", side); });
+    checkQueriesAgree(indexed, scanned, "queries agree after a move out");
+    checkQueriesAgree(indexedSide, scannedSide, "queries agree in the guild moved into");
+
+    onBoth([](Guild& guild, Guild&) { guild.releasePlayer("Hero2"); });
+    checkQueriesAgree(indexed, scanned, "queries agree after a release");
+
+    onBoth([](Guild& guild, Guild&) {
+        guild.setTieringPolicy(TieringPolicy{0, 0});
+        guild.findPlayer("Nobody");
+        guild.demoteIdlePlayers();
+    });
+    check(indexed.getColdPlayerCount() == 4, "every remaining player is demoted");
+    checkQueriesAgree(indexed, scanned, "queries agree over cold players");
+
+    onBoth([](Guild& guild, Guild&) {
+        auto hero = guild.findPlayer("Hero3");
+        hero->getInventoryRef().take(0, 0);
+        hero->getInventoryRef().store(1, 1, Item("Herb", 6.0f, ACCESSORY));
+    });
+    checkQueriesAgree(indexed, scanned, "queries agree after mutating through findPlayer()");
+
+    onBoth([](Guild& guild, Guild&) {
+        guild.modifyPlayer("Hero4", [](Player& hero) { hero.getInventoryRef().store(1, 1, Item("Sword", 3.0f, WEAPON)); });
+        guild.modifyPlayer("Hero5", [](Player& hero) { hero.getInventoryRef().discardEquipped(); });
+    });
+    checkQueriesAgree(indexed, scanned, "queries agree after mutating through modifyPlayer()");
+
+    // Both mutation paths must leave the same answers behind
+    Guild viaFind;
+    Guild viaModify;
+    viaFind.enableIndexes();
+    viaModify.enableIndexes();
+    for (Guild* guild : {&viaFind, &viaModify}) {
+        Player hero("Hero", Inventory(1, 2, std::vector<Item>{Item("Herb", 1.0f, ACCESSORY), Item()}));
+        guild->enlistPlayer(hero);
+        guild->findPlayersCarrying("Herb"); // Both indexes are up to date before the change
+    }
+    viaFind.findPlayer("Hero")->getInventoryRef().store(0, 1, Item("Sword", 5.0f, WEAPON));
+    viaModify.modifyPlayer("Hero", [](Player& hero) { hero.getInventoryRef().store(0, 1, Item("Sword", 5.0f, WEAPON)); });
+    check(viaFind.findPlayersCarrying("Sword") == viaModify.findPlayersCarrying("Sword")
+        && viaFind.findPlayersHeavierThan(5.5f) == viaModify.findPlayersHeavierThan(5.5f)
+        && viaModify.findPlayersHeavierThan(5.5f) == std::vector<std::string>{"Hero"},
+        "findPlayer() and modifyPlayer() mutations are indexed alike");
+
+    indexed.disableIndexes();
+    indexed.enableIndexes();
+    checkQueriesAgree(indexed, scanned, "queries agree after the indexes are rebuilt");
+}
+
+/**
+ * @brief Checks whether two inventories read their cells from the same copy-on-write grid.
+ */
+static bool sharesGrid(const Inventory& lhs, const Inventory& rhs) {
+    return &lhs.view().at(0, 0) == &rhs.view().at(0, 0);
+}
+
+/**
+ * @brief Checks that copies share the grid until their first write, and that every
+ * mutator detaches the copy before writing.
+ */
+void testCopyOnWrite() {
+    std::cout << "\n==== TESTING COPY-ON-WRITE GRIDS ====\n";
+
+    const Inventory original(2, 3, std::vector<Item>{Item("Sword", 3.0, WEAPON), Item("Herb", 0.5, ACCESSORY), Item(),
+                                                     Item("Helm", 2.0, ARMOR), Item(), Item()});
+    const std::vector<std::vector<Item>> items = original.getItems();
+    Inventory assigned(1, 1, std::vector<Item>(1));
+    assigned = original;
+    check(sharesGrid(Inventory(original), original) && sharesGrid(assigned, original),
+        "copies share the grid until they are written");
+
+    std::pair<const char*, std::function<void(Inventory&)>> mutators[] = {
+        {"store", [](Inventory& copy) { copy.store(0, 2, Item("Gem", 0.1, ACCESSORY)); }},
+        {"take", [](Inventory& copy) { copy.take(0, 0); }},
+        {"moveCell", [](Inventory& copy) { copy.moveCell(0, 0, 1, 2); }},
+        {"swapCells", [](Inventory& copy) { copy.swapCells(0, 0, 0, 1); }},
+        {"storeMany", [](Inventory& copy) { copy.storeMany({Item("Gem", 0.1, ACCESSORY)}); }},
+        {"emplace", [](Inventory& copy) { copy.emplace(1, 1, "Gem", 0.1, ACCESSORY); }},
+        {"autoStore", [](Inventory& copy) { copy.autoStore(Item("Gem", 0.1, ACCESSORY)); }},
+    };
+    for (auto& [name, mutate] : mutators) {
+        Inventory copy(original);
+        mutate(copy);
+        std::string what = std::string(name) + " on a copy detaches it and leaves the original unchanged";
+        check(!sharesGrid(copy, original) && copy.getItems() != items && original.getItems() == items
+            && original.getCount() == 3 && original.getWeight() == 5.5f, what.c_str());
+    }
+}
+
+/**
+ * @brief Checks an inventory's per-type tallies and heaviest item against expected values.
+ * Each pair is the expected {count, weight} of WEAPON, ACCESSORY and ARMOR items, and
+ * `heaviest` the expected getMaxItemWeight().
+ */
+static bool tallies(const Inventory& inventory, std::pair<size_t, float> weapons, std::pair<size_t, float> accessories,
+                    std::pair<size_t, float> armor, float heaviest) {
+    return inventory.getCount(WEAPON) == weapons.first && inventory.getWeight(WEAPON) == weapons.second
+        && inventory.getCount(ACCESSORY) == accessories.first && inventory.getWeight(ACCESSORY) == accessories.second
+        && inventory.getCount(ARMOR) == armor.first && inventory.getWeight(ARMOR) == armor.second
+        && inventory.getCount(NONE) == 0 && inventory.getWeight(NONE) == 0 && inventory.getMaxItemWeight() == heaviest;
+}
+
+/**
+ * @brief Checks the per-type counts and weights and the heaviest item weight across
+ * every mutator, copies and moves.
+ */
+void testTypeTallies() {
+    std::cout << "\n==== TESTING TYPE TALLIES ====\n";
+
+    Inventory bag(2, 3, std::vector<Item>{Item("Sword", 3.0, WEAPON), Item("Herb", 0.5, ACCESSORY), Item(),
+                                          Item("Helm", 2.0, ARMOR), Item("Dagger", 1.0, WEAPON), Item()});
+    check(tallies(bag, {2, 4.0f}, {1, 0.5f}, {1, 2.0f}, 3.0f), "a new inventory tallies its grid");
+
+    bag.store(0, 2, Item("Axe", 5.0, WEAPON));
+    check(tallies(bag, {3, 9.0f}, {1, 0.5f}, {1, 2.0f}, 5.0f), "store adds to the tallies and raises the maximum");
+
+    bag.take(0, 2);
+    check(tallies(bag, {2, 4.0f}, {1, 0.5f}, {1, 2.0f}, 3.0f), "taking the heaviest item finds the next heaviest");
+    bag.take(1, 0);
+    check(tallies(bag, {2, 4.0f}, {1, 0.5f}, {0, 0.0f}, 3.0f), "taking a lighter item keeps the maximum");
+    check(bag.take(1, 0).type_ == NONE && tallies(bag, {2, 4.0f}, {1, 0.5f}, {0, 0.0f}, 3.0f),
+        "taking from an empty cell changes nothing");
+
+    bag.moveCell(0, 0, 1, 2);
+    bag.swapCells(0, 1, 1, 1);
+    check(tallies(bag, {2, 4.0f}, {1, 0.5f}, {0, 0.0f}, 3.0f), "moveCell and swapCells leave the tallies alone");
+
+    bag.storeMany({Item("Herb", 0.5, ACCESSORY), Item(), Item("Hammer", 4.0, WEAPON)});
+    check(tallies(bag, {3, 8.0f}, {2, 1.0f}, {0, 0.0f}, 4.0f), "storeMany tallies every placed item");
+
+    Inventory copy(bag);
+    Inventory assigned(1, 1, std::vector<Item>{Item("Pebble", 9.0, ARMOR)});
+    assigned = bag;
+    check(tallies(copy, {3, 8.0f}, {2, 1.0f}, {0, 0.0f}, 4.0f) && tallies(assigned, {3, 8.0f}, {2, 1.0f}, {0, 0.0f}, 4.0f),
+        "copies carry the tallies");
+    Inventory moved(std::move(copy));
+    Inventory moveAssigned(1, 1, std::vector<Item>{Item("Pebble", 9.0, ARMOR)});
+    moveAssigned = std::move(assigned);
+    check(tallies(moved, {3, 8.0f}, {2, 1.0f}, {0, 0.0f}, 4.0f) && tallies(moveAssigned, {3, 8.0f}, {2, 1.0f}, {0, 0.0f}, 4.0f),
+        "moves carry the tallies");
+    check(tallies(copy, {0, 0.0f}, {0, 0.0f}, {0, 0.0f}, 0.0f) && tallies(assigned, {0, 0.0f}, {0, 0.0f}, {0, 0.0f}, 0.0f),
+        "moved-from inventories tally nothing");
+
+    moved.take(1, 2);
+    check(tallies(moved, {2, 5.0f}, {2, 1.0f}, {0, 0.0f}, 4.0f) && tallies(bag, {3, 8.0f}, {2, 1.0f}, {0, 0.0f}, 4.0f),
+        "a copy's tallies change independently of the original");
+}
+
+/**
+ * @brief Lists the names of getHeaviestPlayers(), e.g. "a b c".
+ */
+static std::string heaviestNames(const Guild& guild, size_t count, size_t threads) {
+    std::string names;
+    for (auto playerItr : guild.getHeaviestPlayers(count, threads)) { names += (names.empty() ? "" : " ") + playerItr->getName(); }
+    return names;
+}
+
+/**
+ * @brief Checks that getHeaviestPlayers() ranks enlisted players only, while aggregate()
+ * and findPlayersHeavierThan() also count cold and still-mapped ones.
+ */
+void testHeaviestPlayers() {
+    std::cout << "\n==== TESTING HEAVIEST PLAYERS ====\n";
+
+    const std::string path = (std::filesystem::temp_directory_path() / "mmorpg_heaviest.roster").string();
+    Guild archived;
+    Player giant("Giant", Inventory(1, 1, std::vector<Item>{Item("Boulder", 50.0, WEAPON)}));
+    archived.enlistPlayer(giant);
+    MappedRoster::write(archived, path);
+
+    Guild guild;
+    guild.attachRoster(std::make_shared<const MappedRoster>(path));
+    for (int i = 1; i <= 3; i++) {
+        Player player("Hero" + std::to_string(i), Inventory(1, 1, std::vector<Item>{Item("Pack", 10.0f * i, ACCESSORY)}));
+        guild.enlistPlayer(player);
+    }
+    guild.setTieringPolicy(TieringPolicy{1, 0});
+    guild.findPlayer("Hero1");
+    guild.findPlayer("Hero2"); // Hero3 is now the only player idle for more than one access
+    check(guild.demoteIdlePlayers() == 1 && guild.getColdPlayerCount() == 1 && guild.getMappedPlayerCount() == 1,
+        "the heaviest hero is cold and the giant still mapped");
+
+    check(heaviestNames(guild, 4, 1) == "Hero2 Hero1" && heaviestNames(guild, 4, 2) == "Hero2 Hero1",
+        "getHeaviestPlayers ranks enlisted players only");
+    GuildStats stats = guild.aggregate(1);
+    check(stats.player_count == 4 && stats.total_weight == 110.0f, "aggregate still counts cold and mapped players");
+    check(guild.findPlayersHeavierThan(0) == std::vector<std::string>{"Giant", "Hero3", "Hero2", "Hero1"},
+        "findPlayersHeavierThan ranks the whole guild");
+
+    guild.findPlayer("Giant");
+    guild.findPlayer("Hero3");
+    check(heaviestNames(guild, 2, 1) == "Giant Hero3", "looked-up players are ranked again");
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Checks FixedInventory's mutators and its conversions to and from Inventory.
+ */
+void testFixedInventory() {
+    std::cout << "\n==== TESTING FIXED INVENTORIES ====\n";
+
+    static_assert(Pouch::cellIndex(3, 2) == 14, "cellIndex is usable in constant expressions");
+    Pouch pouch(new Item("Buckler", 3.0, ARMOR));
+    check(pouch.store(0, 1, Item("Herb", 0.5, ACCESSORY)) && !pouch.store(0, 1, Item("Gem", 0.1, ACCESSORY))
+        && pouch.getCount() == 1 && pouch.getWeight() == 0.5f, "store fills an empty cell and refuses an occupied one");
+    bool threw = false;
+    try { pouch.store(4, 0, Item("Gem", 0.1, ACCESSORY)); } catch (const std::out_of_range&) { threw = true; }
+    check(threw, "store rejects a cell outside the grid");
+
+    auto first = pouch.autoStore(Item("Dagger", 1.0, WEAPON));
+    auto second = pouch.autoStore(Item("Rope", 2.0, ACCESSORY));
+    check(first == std::make_pair(size_t(0), size_t(0)) && second == std::make_pair(size_t(0), size_t(2))
+        && pouch.getCount() == 3 && pouch.getWeight() == 3.5f, "autoStore takes the first free cells in row-major order");
+    Pouch full;
+    for (size_t i = 0; i < 16; i++) { full.autoStore(Item("Pebble", 1.0, ACCESSORY)); }
+    check(!full.autoStore(Item("Pebble", 1.0, ACCESSORY)) && full.getCount() == 16, "autoStore refuses a full grid");
+
+    Item dagger = pouch.take(0, 0);
+    check(dagger.name_ == "Dagger" && pouch.at(0, 0).type_ == NONE && pouch.getCount() == 2 && pouch.getWeight() == 2.5f,
+        "take moves the item out and updates the totals");
+    check(pouch.take(0, 0).type_ == NONE && pouch.getCount() == 2, "taking from an empty cell changes nothing");
+
+    Inventory copied = pouch.toInventory();
+    check(copied.getRows() == 4 && copied.getCols() == 4 && copied.getCount() == 2 && copied.getWeight() == 2.5f
+        && copied.getItems()[0][1].name_ == "Herb" && copied.getEquipped() && copied.getEquipped() != pouch.getEquipped()
+        && pouch.getCount() == 2, "toInventory() copies the grid and the equipped item");
+    Inventory moved = std::move(pouch).toInventory();
+    check(moved.getCount() == 2 && moved.getItems()[0][2].name_ == "Rope" && moved.getEquipped()
+        && pouch.getCount() == 0 && pouch.getWeight() == 0 && !pouch.getEquipped() && pouch.at(0, 1).type_ == NONE,
+        "toInventory() && moves everything out and leaves the pouch empty");
+
+    Pouch restored(moved);
+    check(restored.getCount() == 2 && restored.getWeight() == 2.5f && restored.at(0, 2).name_ == "Rope"
+        && restored.getEquipped() && restored.getEquipped()->name_ == "Buckler", "a FixedInventory copies a same-shaped Inventory");
+    threw = false;
+    try { Pouch wrong(Inventory(4, 5, std::vector<Item>(20))); } catch (const std::invalid_argument&) { threw = true; }
+    check(threw, "a differently shaped Inventory is rejected");
+}
+
+/**
+ * @brief Checks the lifecycle counters. They are only compiled in by `make test-instrumented`;
+ * otherwise every snapshot must read zero.
+ */
+void testInstrumentation() {
+    std::cout << "\n==== TESTING INSTRUMENTATION ====\n";
+
+    using Counters = Instrumentation;
+    Player source("Tracked", Inventory(2, 2, std::vector<Item>(4, Item("Arrow", 0.1, WEAPON)), new Item("Quiver", 1.0, ARMOR)));
+    if (!Counters::ENABLED) {
+        Counters::Snapshot totals = Counters::snapshot();
+        check(std::all_of(totals.values.begin(), totals.values.end(), [](std::uint64_t value) { return value == 0; }),
+            "the counters read zero when compiled out");
+        return;
+    }
+
+    Counters::Snapshot before = Counters::snapshot();
+    Player copy(source);
+    Counters::Snapshot copied = Counters::snapshot().since(before);
+    check(copied.get(Counters::PLAYER_COPY_CONSTRUCTED) == 1 && copied.get(Counters::INVENTORY_COPY_CONSTRUCTED) == 1
+        && copied.get(Counters::EQUIPPED_ALLOCATED) == 1 && copied.get(Counters::GRID_COPIES) == 0
+        && copied.get(Counters::PLAYER_MOVE_CONSTRUCTED) == 0, "a copy counts one player and inventory copy and one equipped item");
+
+    before = Counters::snapshot();
+    Player moved(std::move(copy));
+    Counters::Snapshot movedCounts = Counters::snapshot().since(before);
+    check(movedCounts.get(Counters::PLAYER_MOVE_CONSTRUCTED) == 1 && movedCounts.get(Counters::INVENTORY_MOVE_CONSTRUCTED) == 1
+        && movedCounts.get(Counters::PLAYER_COPY_CONSTRUCTED) == 0 && movedCounts.get(Counters::INVENTORY_COPY_CONSTRUCTED) == 0
+        && movedCounts.get(Counters::EQUIPPED_ALLOCATED) == 0, "a move counts one player and inventory move and nothing else");
+
+    before = Counters::snapshot();
+    moved.getInventoryRef().take(0, 0);
+    Counters::Snapshot written = Counters::snapshot().since(before);
+    check(written.get(Counters::GRID_COPIES) == 1 && written.get(Counters::GRID_BYTES_COPIED) == 4 * sizeof(Item),
+        "the first write to a shared grid counts one grid copy");
+
+    before = Counters::snapshot();
+    std::thread([&] { Player late(source); }).join();
+    Counters::Snapshot exited = Counters::snapshot().since(before);
+    check(exited.get(Counters::PLAYER_COPY_CONSTRUCTED) == 1 && exited.get(Counters::PLAYER_DESTROYED) == 1,
+        "an exited thread's counts are kept");
+}
+
+/**
+ * @brief Checks that RecordView recomputes its totals from the cells, as decode() does,
+ * rather than trusting the record header.
+ */
+void testRecordTotals() {
+    std::cout << "\n==== TESTING RECORD TOTALS ====\n";
+
+    // Store and take out of row-major order, so the running weight may differ from a fresh sum
+    Inventory bag(1, 4, std::vector<Item>(4));
+    bag.store(0, 3, Item("Herb", 0.1, ACCESSORY));
+    bag.store(0, 0, Item("Dagger", 0.2, WEAPON));
+    bag.store(0, 1, Item("Helm", 0.7, ARMOR));
+    bag.store(0, 2, Item("Rope", 0.3, ACCESSORY));
+    bag.take(0, 1);
+    std::vector<std::uint8_t> record = PlayerCodec::encode(Player("Arthur", bag));
+    PlayerCodec::RecordView view(record.data(), record.size());
+    Player decoded = PlayerCodec::decode(record);
+    check(view.getWeight() == decoded.getInventoryRef().getWeight() && view.getCount() == 3
+        && decoded.getInventoryRef().getCount() == 3, "a view's totals match the decoded inventory exactly");
+
+    // The header's count and weight are the u32 at offset 16 and the f32 at offset 20
+    std::vector<std::uint8_t> staleWeight = record;
+    const float bogus = 1000.0f;
+    std::memcpy(staleWeight.data() + 20, &bogus, sizeof(bogus));
+    PlayerCodec::RecordView stale(staleWeight.data(), staleWeight.size());
+    check(stale.getWeight() == view.getWeight() && PlayerCodec::decode(staleWeight).getInventoryRef().getWeight() == view.getWeight(),
+        "a wrong header weight is ignored by both the view and decode");
+
+    std::vector<std::uint8_t> staleCount = record;
+    staleCount[16] = 1;
+    PlayerCodec::RecordView miscounted(staleCount.data(), staleCount.size());
+    bool threw = false;
+    try { PlayerCodec::decode(staleCount); } catch (const std::invalid_argument&) { threw = true; }
+    check(miscounted.getCount() == 3 && threw, "a wrong header count is ignored by the view and rejected by decode");
+}
+
+/**
+ * @brief Runs every check and reports how many failed.
+ */
+int main() {
+    testCodecRoundTrip();
+    testCodecRejectsBadHeaders();
+    testDemotion();
+    testJoinOrder();
+    testBatchGrowth();
+    testItemPoolCrossThread();
+    testSnapshots();
+    testPackedCells();
+    testChangeTracking();
+    testFailedAppend();
+    testArenaAssignment();
+    testCopiedChanges();
+    testInboxFailure();
+    testConcurrentGuild();
+    testMappedRoster();
+    testRosterStream();
+    testIndexedQueries();
+    testCopyOnWrite();
+    testTypeTallies();
+    testHeaviestPlayers();
+    testFixedInventory();
+    testInstrumentation();
+    testRecordTotals();
+
+    std::cout << "\n" << (failures == 0 ? "All checks passed.\n" : "Some checks FAILED.\n");
+    return failures == 0 ? 0 : 1;
+}